@@ -0,0 +1,471 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "listas.h"
+
+
+// -----------------------------------------------------------------------------
+// Programa de medida de las operaciones de listas
+//
+// Uso: bench [-n tamaños] [-d distribución] [-r repeticiones] [-b búsquedas]
+//            [-s semilla] [-p distancias] [-f texto|csv|json]
+//   -n  lista de tamaños separados por comas (1000,10000,100000,1000000)
+//   -d  aleatoria, ordenada, inversa, duplicados o todas (todas)
+//   -r  repeticiones de cada medida (3)
+//   -b  búsquedas y borrados por repetición (10)
+//   -p  distancias de precarga separadas por comas, 0 sin precarga (4)
+//
+// Para cada medida muestra ns por llamada (media y mínimo), elementos
+// procesados por segundo, reservas de memoria por llamada y el pico de
+// memoria residente del proceso hasta ese momento (nunca baja: no es la
+// memoria de esa medida sino la mayor de todas las anteriores). Las reservas
+// se cuentan envolviendo malloc al enlazar (-Wl,--wrap=malloc ...)
+// -----------------------------------------------------------------------------
+
+// Máximo de distancias de precarga distintas en -p
+#define MAX_DISTANCIAS 16
+
+// Formatos de salida
+enum FORMATOS_ENUM { TEXTO, CSV, JSON };
+typedef enum FORMATOS_ENUM TFormato;
+
+// Distribuciones de las claves (en el orden en que quedan en la lista)
+enum DISTRIBUCIONES_ENUM { ALEATORIA, ORDENADA, INVERSA, DUPLICADOS, NUM_DISTRIBUCIONES };
+typedef enum DISTRIBUCIONES_ENUM TDistribucion;
+
+const char* nombres_distribucion[NUM_DISTRIBUCIONES] = { "aleatoria", "ordenada", "inversa", "duplicados" };
+
+// Acumulado de las repeticiones de una operación
+typedef struct medida
+{
+	const char* operacion;
+	double      total_ns;
+	double      min_ns;
+	long        llamadas;       // llamadas por repetición
+	long        elementos;      // elementos procesados por repetición
+	long        reservas;       // total de reservas en todas las repeticiones
+} TMedida;
+
+
+// -----------------------------------------------------------------------------
+// Contadores de reservas de memoria
+// -----------------------------------------------------------------------------
+long num_reservas = 0;
+long num_liberaciones = 0;
+
+void* __real_malloc (size_t tam);
+void* __real_calloc (size_t n, size_t tam);
+void* __real_realloc (void* ptr, size_t tam);
+void  __real_free (void* ptr);
+
+void* __wrap_malloc (size_t tam)
+{
+	num_reservas++;
+	return __real_malloc (tam);
+}
+
+void* __wrap_calloc (size_t n, size_t tam)
+{
+	num_reservas++;
+	return __real_calloc (n, tam);
+}
+
+void* __wrap_realloc (void* ptr, size_t tam)
+{
+	if (ptr == NULL)
+		num_reservas++;
+	return __real_realloc (ptr, tam);
+}
+
+void __wrap_free (void* ptr)
+{
+	if (ptr != NULL)
+		num_liberaciones++;
+	__real_free (ptr);
+}
+
+
+// -----------------------------------------------------------------------------
+// Generador pseudoaleatorio (xorshift64*), rápido y reproducible
+// -----------------------------------------------------------------------------
+uint64_t estado_aleatorio = 88172645463325252ULL;
+
+uint64_t aleatorio (void)
+{
+	estado_aleatorio ^= estado_aleatorio >> 12;
+	estado_aleatorio ^= estado_aleatorio << 25;
+	estado_aleatorio ^= estado_aleatorio >> 27;
+	return estado_aleatorio * 2685821657736338717ULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// Elementos: enteros reservados dinámicamente, como en test.c
+// -----------------------------------------------------------------------------
+int comparar_elementos (TElemento a, TElemento b)
+{
+	int e1 = *((int*)a);
+	int e2 = *((int*)b);
+	
+	return (e1 > e2) - (e1 < e2);
+}
+
+long suma_recorrido = 0;
+
+void sumar_elemento (TElemento e)
+{
+	suma_recorrido += *((int*)e);
+}
+
+void destruir_elemento (TElemento e)
+{
+	free (e);
+}
+
+TElemento crear_elemento (int e)
+{
+	int* ptrint;
+	ptrint = malloc (sizeof(int));
+	*ptrint = e;
+	return ptrint;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la clave i-ésima de n según la distribución
+// -----------------------------------------------------------------------------
+int generar_clave (TDistribucion d, int i, int n)
+{
+	switch (d)
+	{
+		case ORDENADA:
+			return i;
+		case INVERSA:
+			return n - i;
+		case DUPLICADOS:
+			return (int)(aleatorio() % 16);
+		default:
+			return (int)(aleatorio() % (uint64_t)n);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// Medida de tiempos
+// -----------------------------------------------------------------------------
+double ahora_ns (void)
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+long pico_memoria_kb (void)
+{
+	struct rusage uso;
+	getrusage (RUSAGE_SELF, &uso);
+	return uso.ru_maxrss;
+}
+
+void iniciar_medida (TMedida* m, const char* operacion)
+{
+	m->operacion = operacion;
+	m->total_ns = 0;
+	m->min_ns = -1;
+	m->llamadas = 0;
+	m->elementos = 0;
+	m->reservas = 0;
+}
+
+// Marca de inicio de una medida: tiempo y reservas
+typedef struct marca
+{
+	double t;
+	long   reservas;
+} TMarca;
+
+TMarca marcar (void)
+{
+	TMarca marca;
+	marca.reservas = num_reservas;
+	marca.t = ahora_ns();
+	return marca;
+}
+
+void anotar (TMedida* m, TMarca marca, long llamadas, long elementos)
+{
+	double ns;
+	
+	ns = ahora_ns() - marca.t;
+	m->total_ns += ns;
+	if ((m->min_ns < 0) || (ns < m->min_ns))
+		m->min_ns = ns;
+	m->llamadas = llamadas;
+	m->elementos = elementos;
+	m->reservas += num_reservas - marca.reservas;
+}
+
+
+// -----------------------------------------------------------------------------
+// Salida
+// -----------------------------------------------------------------------------
+int primera_fila = 1;
+
+void mostrar_cabecera (TFormato formato)
+{
+	if (formato == CSV)
+		printf ("operacion,distribucion,n,prebusqueda,repeticiones,llamadas,ns_llamada,ns_llamada_min,elementos_s,reservas_llamada,pico_rss_proceso_kb\n");
+	else if (formato == JSON)
+		printf ("[");
+	else
+		printf ("%-18s %-11s %10s %5s %14s %14s %14s %10s %17s\n", "operacion", "distribucion", "n",
+		        "prec.", "ns/llamada", "ns/ll. (min)", "elementos/s", "reservas", "pico RSS proc. KB");
+}
+
+void mostrar_medida (TFormato formato, TMedida* m, TDistribucion d, int n, int distancia, int reps)
+{
+	double ns, ns_min, elementos_s, reservas;
+	
+	ns = m->total_ns / reps / m->llamadas;
+	ns_min = m->min_ns / m->llamadas;
+	elementos_s = (m->total_ns > 0) ? m->elementos * reps / (m->total_ns / 1e9) : 0;
+	reservas = (double)m->reservas / reps / m->llamadas;
+	
+	if (formato == CSV)
+		printf ("%s,%s,%d,%d,%d,%ld,%.1f,%.1f,%.0f,%.2f,%ld\n", m->operacion, nombres_distribucion[d], n,
+		        distancia, reps, m->llamadas, ns, ns_min, elementos_s, reservas, pico_memoria_kb());
+	else if (formato == JSON)
+	{
+		printf ("%s\n  {\"operacion\": \"%s\", \"distribucion\": \"%s\", \"n\": %d, \"prebusqueda\": %d, \"repeticiones\": %d, "
+		        "\"llamadas\": %ld, \"ns_llamada\": %.1f, \"ns_llamada_min\": %.1f, \"elementos_s\": %.0f, "
+		        "\"reservas_llamada\": %.2f, \"pico_rss_proceso_kb\": %ld}",
+		        primera_fila ? "" : ",", m->operacion, nombres_distribucion[d], n, distancia, reps, m->llamadas,
+		        ns, ns_min, elementos_s, reservas, pico_memoria_kb());
+		primera_fila = 0;
+	}
+	else
+		printf ("%-18s %-11s %10d %5d %14.1f %14.1f %14.0f %10.2f %17ld\n", m->operacion, nombres_distribucion[d],
+		        n, distancia, ns, ns_min, elementos_s, reservas, pico_memoria_kb());
+	fflush (stdout);
+}
+
+void mostrar_pie (TFormato formato)
+{
+	if (formato == JSON)
+		printf ("\n]\n");
+}
+
+
+// -----------------------------------------------------------------------------
+// Mide todas las operaciones para un tamaño y una distribución
+// -----------------------------------------------------------------------------
+
+// Operaciones medidas, en el orden en que se ejecutan en cada repetición
+enum OPERACIONES_ENUM { INSERTAR_LOTE, INSERTAR, RECORRER, BUSCAR, ORDENAR, BORRAR, DESTRUIR, NUM_OPERACIONES };
+
+void medir (TFormato formato, TDistribucion d, int n, int distancia, int reps, int busquedas)
+{
+	TMedida medidas[NUM_OPERACIONES];
+	TElemento* elementos;
+	int* claves;
+	TLista lista;
+	TPoolNodos* pool;
+	TMarca marca;
+	int r, i;
+	
+	iniciar_medida (&medidas[INSERTAR_LOTE], "insertar_lote_pool");
+	iniciar_medida (&medidas[INSERTAR], "insertar_elemento");
+	iniciar_medida (&medidas[RECORRER], "recorrer");
+	iniciar_medida (&medidas[BUSCAR], "buscar_elemento");
+	iniciar_medida (&medidas[ORDENAR], "ordenar_lista");
+	iniciar_medida (&medidas[BORRAR], "borrar_elemento");
+	iniciar_medida (&medidas[DESTRUIR], "destruir_lista");
+	
+	elementos = malloc (n * sizeof(TElemento));
+	claves = malloc (busquedas * sizeof(int));
+	fijar_prebusqueda (distancia);
+	
+	for (r=0; r<reps; r++)
+	{
+		// Los elementos se crean fuera de la medida y se insertan del último
+		// al primero para que la lista quede en el orden de la distribución
+		for (i=0; i<n; i++)
+			elementos[i] = crear_elemento (generar_clave (d, i, n));
+		for (i=0; i<busquedas; i++)
+			claves[i] = generar_clave (d, (int)(aleatorio() % (uint64_t)n), n);
+		
+		// Con pool los n nodos salen de una sola reserva. La lista se descarta
+		// sin destruir los elementos, que se usan a continuación
+		pool = crear_pool_nodos (0);
+		lista = crear_lista_vacia();
+		marca = marcar();
+		insertar_lote_pool (&lista, elementos, n, pool);
+		anotar (&medidas[INSERTAR_LOTE], marca, 1, n);
+		destruir_pool_nodos (pool);
+		
+		lista = crear_lista_vacia();
+		marca = marcar();
+		for (i=n-1; i>=0; i--)
+			insertar_elemento (&lista, elementos[i]);
+		anotar (&medidas[INSERTAR], marca, n, n);
+		
+		marca = marcar();
+		recorrer (lista, sumar_elemento);
+		anotar (&medidas[RECORRER], marca, 1, n);
+		
+		marca = marcar();
+		for (i=0; i<busquedas; i++)
+			buscar_elemento (lista, &claves[i], comparar_elementos);
+		anotar (&medidas[BUSCAR], marca, busquedas, (long)busquedas * n);
+		
+		marca = marcar();
+		ordenar_lista (&lista, comparar_elementos);
+		anotar (&medidas[ORDENAR], marca, 1, n);
+		
+		marca = marcar();
+		for (i=0; i<busquedas; i++)
+			borrar_elemento (&lista, &claves[i], 0, comparar_elementos, destruir_elemento);
+		anotar (&medidas[BORRAR], marca, busquedas, (long)busquedas * n);
+		
+		marca = marcar();
+		destruir_lista (&lista, destruir_elemento);
+		anotar (&medidas[DESTRUIR], marca, 1, n);
+	}
+	
+	for (i=0; i<NUM_OPERACIONES; i++)
+		mostrar_medida (formato, &medidas[i], d, n, distancia, reps);
+	
+	free (claves);
+	free (elementos);
+}
+
+
+// -----------------------------------------------------------------------------
+// Muestra el uso del programa y devuelve el código de salida de error
+// -----------------------------------------------------------------------------
+int mostrar_uso (const char* programa)
+{
+	fprintf (stderr, "Uso: %s [-n tamaños] [-d aleatoria|ordenada|inversa|duplicados|todas] [-r repeticiones] "
+	         "[-b búsquedas] [-s semilla] [-p distancias] [-f texto|csv|json]\n", programa);
+	return 1;
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN
+// -----------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	char tamanos_defecto[] = "1000,10000,100000,1000000";
+	char* tamanos;
+	char* tam;
+	int distancias[MAX_DISTANCIAS];
+	int reps, busquedas, opcion, n;
+	int desde, hasta, d, p, num_distancias;
+	TFormato formato;
+	
+	tamanos = tamanos_defecto;
+	reps = 3;
+	busquedas = 10;
+	formato = TEXTO;
+	desde = 0;
+	hasta = NUM_DISTRIBUCIONES - 1;
+	distancias[0] = 4;
+	num_distancias = 1;
+	
+	while ((opcion = getopt (argc, argv, "n:d:r:b:s:p:f:")) != -1)
+	{
+		switch (opcion)
+		{
+			case 'n':
+				tamanos = optarg;
+				break;
+			case 'd':
+				for (d=0; d<NUM_DISTRIBUCIONES; d++)
+				{
+					if (strcmp (optarg, nombres_distribucion[d]) == 0)
+						break;
+				}
+				if (d < NUM_DISTRIBUCIONES)
+					desde = hasta = d;
+				else if (strcmp (optarg, "todas") == 0)
+				{
+					desde = 0;
+					hasta = NUM_DISTRIBUCIONES - 1;
+				}
+				else
+					return mostrar_uso (argv[0]);
+				break;
+			case 'r':
+				reps = atoi (optarg);
+				break;
+			case 'b':
+				busquedas = atoi (optarg);
+				break;
+			case 's':
+				estado_aleatorio = strtoull (optarg, NULL, 10) | 1;
+				break;
+			case 'p':
+				num_distancias = 0;
+				for (tam = strtok (optarg, ","); (tam != NULL) && (num_distancias < MAX_DISTANCIAS); tam = strtok (NULL, ","))
+					distancias[num_distancias++] = atoi (tam);
+				break;
+			case 'f':
+				if (strcmp (optarg, "csv") == 0)
+					formato = CSV;
+				else if (strcmp (optarg, "json") == 0)
+					formato = JSON;
+				else if (strcmp (optarg, "texto") == 0)
+					formato = TEXTO;
+				else
+					return mostrar_uso (argv[0]);
+				break;
+			default:
+				return mostrar_uso (argv[0]);
+		}
+	}
+	
+	if ((reps < 1) || (busquedas < 1) || (num_distancias < 1))
+		return 1;
+	
+	mostrar_cabecera (formato);
+	for (tam = strtok (tamanos, ","); tam != NULL; tam = strtok (NULL, ","))
+	{
+		n = atoi (tam);
+		if (n < 1)
+			continue;
+		for (d=desde; d<=hasta; d++)
+			for (p=0; p<num_distancias; p++)
+				medir (formato, d, n, distancias[p], reps, busquedas);
+	}
+	mostrar_pie (formato);
+	
+	return 0;
+}
@@ -22,18 +22,187 @@ THE SOFTWARE.
 
 
 #include "listas.h"
+#include "listas_indice.h"
+#include "listas_estadisticas.h"
 #include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+
+// Nodos de adelanto por defecto al precargar en los recorridos
+#define PREBUSQUEDA_DISTANCIA 4
+
+// Precarga en caché de un nodo o de su dato (no falla con punteros inválidos)
+#if defined(__GNUC__) && !defined(LISTAS_SIN_PREBUSQUEDA)
+#define PRECARGAR(ptr) __builtin_prefetch (ptr)
+#else
+#define PRECARGAR(ptr)
+#endif
+
+// Nodo con su clave para ordenar_lista_por_clave
+typedef struct par_clave
+{
+	uint64_t    clave;
+	TNodoLista* nodo;
+} TParClave;
+
+// Funciones de una operación, pasadas como contexto a las operaciones de
+// listas_especializadas_plantilla.h (la comparación es una llamada indirecta)
+typedef struct llamada
+{
+	FComparar    comparar;
+	FMap         map;
+	FCompararCtx comparar_ctx;
+	FMapCtx      map_ctx;
+	void*        contexto;
+} TLlamada;
+
+// Nodos por bloque cuando no se indica un tamaño al crear el pool
+#define POOL_NODOS_POR_BLOQUE 1024
+
+// Bloque de nodos reservado de una sola vez
+typedef struct bloque_nodos
+{
+	struct bloque_nodos* sig;
+	TNodoLista           nodos[];
+} TBloqueNodos;
+
+// Pool de nodos: bloques enlazados y lista libre intrusiva (por next)
+struct pool_nodos
+{
+	TBloqueNodos* bloques;          // el primero es el bloque en uso
+	int           usados;           // nodos ya entregados del bloque en uso
+	int           nodos_por_bloque;
+	TNodoLista*   libres;           // nodos devueltos pendientes de reutilizar
+};
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TPoolNodos* crear_pool_nodos (int nodos_por_bloque)
+{
+	TPoolNodos* pool;
+	pool = (TPoolNodos*)malloc(sizeof(TPoolNodos));
+	
+	if (nodos_por_bloque < 1)
+		nodos_por_bloque = POOL_NODOS_POR_BLOQUE;
+	
+	pool->bloques = NULL;
+	pool->usados = 0;
+	pool->nodos_por_bloque = nodos_por_bloque;
+	pool->libres = NULL;
+	
+	return pool;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Libera de golpe todos los bloques del pool, el pool queda vacío y
+//       puede seguir utilizándose
+// O(b) siendo b el número de bloques
+// -----------------------------------------------------------------------------
+void vaciar_pool_nodos (TPoolNodos* pool)
+{
+	TBloqueNodos* bloque;
+	
+	while (pool->bloques != NULL)
+	{
+		bloque = pool->bloques;
+		pool->bloques = bloque->sig;
+		free (bloque);
+		EST_LIBERACIONES (1);
+	}
+	pool->usados = 0;
+	pool->libres = NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(b) siendo b el número de bloques
+// -----------------------------------------------------------------------------
+void destruir_pool_nodos (TPoolNodos* pool)
+{
+	if (pool == NULL)
+		return;
+	
+	vaciar_pool_nodos (pool);
+	free (pool);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Reserva un bloque de n nodos y lo añade al pool
+//       Si n es el tamaño normal de bloque pasa a ser el bloque en uso, si no
+//       se queda detrás del bloque en uso y se considera lleno
+// O(1)
+// -----------------------------------------------------------------------------
+TBloqueNodos* nuevo_bloque_pool (TPoolNodos* pool, size_t n)
+{
+	TBloqueNodos* bloque;
+	bloque = (TBloqueNodos*)malloc(sizeof(TBloqueNodos) + n * sizeof(TNodoLista));
+	EST_RESERVAS (1);
+	
+	if ((n == (size_t)pool->nodos_por_bloque) || (pool->bloques == NULL))
+	{
+		bloque->sig = pool->bloques;
+		pool->bloques = bloque;
+		pool->usados = (n == (size_t)pool->nodos_por_bloque) ? 0 : pool->nodos_por_bloque;
+	}
+	else
+	{
+		bloque->sig = pool->bloques->sig;
+		pool->bloques->sig = bloque;
+	}
+	return bloque;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: n > 0
+// POST: Devuelve n nodos consecutivos en memoria tomados del pool, sin
+//       inicializar. Si no caben en el bloque en uso se reserva otro
+// O(1)
+// -----------------------------------------------------------------------------
+TNodoLista* reservar_nodos_pool (TPoolNodos* pool, size_t n)
+{
+	TNodoLista* ptr;
+	
+	// Un lote mayor que un bloque normal va en un bloque propio
+	if (n > (size_t)pool->nodos_por_bloque)
+		return nuevo_bloque_pool (pool, n)->nodos;
+	
+	if ((pool->bloques == NULL) || ((size_t)pool->usados + n > (size_t)pool->nodos_por_bloque))
+		nuevo_bloque_pool (pool, pool->nodos_por_bloque);
+	
+	ptr = &(pool->bloques->nodos[pool->usados]);
+	pool->usados += n;
+	return ptr;
+}
 
 
 // -----------------------------------------------------------------------------
 // POST: Crea un nodo nuevo a partir de el elemento e y la dirección del
-//       siguiente nodo
+//       siguiente nodo. Si pool no es nulo el nodo sale del pool, primero de
+//       la lista libre y si está vacía del bloque en uso
 // O(1)
 // -----------------------------------------------------------------------------
-TNodoLista* crear_nodo (TElemento e, TNodoLista* sig)
+TNodoLista* crear_nodo_pool (TElemento e, TNodoLista* sig, TPoolNodos* pool)
 {
 	TNodoLista* ptr;
-	ptr = (TNodoLista*)malloc(sizeof(TNodoLista));
+	
+	if (pool == NULL)
+	{
+		ptr = (TNodoLista*)malloc(sizeof(TNodoLista));
+		EST_RESERVAS (1);
+	}
+	else if (pool->libres != NULL)
+	{
+		ptr = pool->libres;
+		pool->libres = ptr->next;
+	}
+	else
+		ptr = reservar_nodos_pool (pool, 1);
 	
 	ptr->dato = e;
 	ptr->next = sig;
@@ -42,6 +211,158 @@ TNodoLista* crear_nodo (TElemento e, TNodoLista* sig)
 }
 
 
+// -----------------------------------------------------------------------------
+// POST: Crea una cadena de nodos con los n elementos de v, en el orden de v o
+//       al revés si invertir!=0, terminada en sig y devuelve su primer nodo
+//       (sig si n es 0). *ptrultimo apunta al último nodo creado en la cadena
+//       Con pool los n nodos son consecutivos en memoria y en el orden de la
+//       cadena (una sola reserva)
+// O(n)
+// -----------------------------------------------------------------------------
+TNodoLista* crear_cadena (TElemento* v, size_t n, int invertir, TNodoLista* sig, TPoolNodos* pool, TNodoLista** ptrultimo)
+{
+	TNodoLista* nodos;
+	size_t i;
+	
+	if (n == 0)
+		return sig;
+	
+	if (pool == NULL)
+	{
+		// Se crea desde el final para que cada nodo apunte al ya creado
+		for (i=0; i<n; i++)
+		{
+			sig = crear_nodo_pool (invertir ? v[i] : v[n-1-i], sig, NULL);
+			if (i == 0)
+				*ptrultimo = sig;
+		}
+		return sig;
+	}
+	
+	nodos = reservar_nodos_pool (pool, n);
+	for (i=0; i<n; i++)
+	{
+		nodos[i].dato = invertir ? v[n-1-i] : v[i];
+		nodos[i].next = &(nodos[i+1]);
+	}
+	nodos[n-1].next = sig;
+	*ptrultimo = &(nodos[n-1]);
+	
+	return nodos;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TNodoLista* crear_nodo (TElemento e, TNodoLista* sig)
+{
+	return crear_nodo_pool (e, sig, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el nodo al pool (a su lista libre) o lo libera si pool es nulo
+// O(1)
+// -----------------------------------------------------------------------------
+void liberar_nodo (TNodoLista* ptrnodo, TPoolNodos* pool)
+{
+	if (pool == NULL)
+	{
+		free (ptrnodo);
+		EST_LIBERACIONES (1);
+		return;
+	}
+	ptrnodo->next = pool->libres;
+	pool->libres = ptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// Precarga en los recorridos
+// Un puntero adelantado va distancia nodos por delante del recorrido y va
+// precargando su nodo siguiente y su dato (que suele ser un puntero), de modo
+// que cuando el recorrido llega a ellos ya están en caché
+// -----------------------------------------------------------------------------
+#ifdef LISTAS_SIN_PREBUSQUEDA
+static int distancia_prebusqueda = 0;
+#else
+static int distancia_prebusqueda = PREBUSQUEDA_DISTANCIA;
+#endif
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+void fijar_prebusqueda (int distancia)
+{
+#ifndef LISTAS_SIN_PREBUSQUEDA
+	distancia_prebusqueda = (distancia > 0) ? distancia : 0;
+#else
+	(void)distancia;
+#endif
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Precarga los primeros nodos y devuelve el puntero adelantado
+//       distancia_prebusqueda nodos, o NULL si no hay precarga o la lista es
+//       más corta
+// O(distancia)
+// -----------------------------------------------------------------------------
+TNodoLista* iniciar_prebusqueda (TNodoLista* ptrnodo)
+{
+	int i;
+	
+	if (distancia_prebusqueda == 0)
+		return NULL;
+	
+	for (i=0; (i<distancia_prebusqueda) && (ptrnodo != NULL); i++)
+	{
+		PRECARGAR (ptrnodo->dato);
+		ptrnodo = ptrnodo->next;
+	}
+	return ptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: adelantado no es nulo
+// POST: Precarga el siguiente y el dato del nodo adelantado y lo avanza
+// O(1)
+// -----------------------------------------------------------------------------
+TNodoLista* avanzar_prebusqueda (TNodoLista* adelantado)
+{
+	PRECARGAR (adelantado->next);
+	PRECARGAR (adelantado->dato);
+	return adelantado->next;
+}
+
+
+// -----------------------------------------------------------------------------
+// Recorrido, búsqueda y ordenación de las operaciones de listas.h: la misma
+// plantilla que listas_especializadas.h, con precarga y estadísticas, una
+// vez para FComparar/FMap (_llamada) y otra para las de contexto (_llamada_ctx)
+// -----------------------------------------------------------------------------
+#define LE_NODO() EST_NODOS (1)
+#define LE_PRECARGA_INICIO(ptrnodo) TNodoLista* adelantado = iniciar_prebusqueda (ptrnodo)
+#define LE_PRECARGA_PASO() if (adelantado != NULL) adelantado = avanzar_prebusqueda (adelantado)
+
+#define LE_SUFIJO _llamada
+#define LE_COMPARAR(e1, e2, c) (((TLlamada*)(c))->comparar ((e1), (e2)))
+#define LE_MAP(e, c) (((TLlamada*)(c))->map (e))
+#include "listas_especializadas_plantilla.h"
+
+#define LE_NODO() EST_NODOS (1)
+#define LE_PRECARGA_INICIO(ptrnodo) TNodoLista* adelantado = iniciar_prebusqueda (ptrnodo)
+#define LE_PRECARGA_PASO() if (adelantado != NULL) adelantado = avanzar_prebusqueda (adelantado)
+
+#define LE_SUFIJO _llamada_ctx
+#define LE_COMPARAR(e1, e2, c) (((TLlamada*)(c))->comparar_ctx ((e1), (e2), ((TLlamada*)(c))->contexto))
+#define LE_MAP(e, c) (((TLlamada*)(c))->map_ctx ((e), ((TLlamada*)(c))->contexto))
+#include "listas_especializadas_plantilla.h"
+
+
 // -----------------------------------------------------------------------------
 // O(1)
 // -----------------------------------------------------------------------------
@@ -61,78 +382,167 @@ int es_lista_vacia (TLista lista)
 
 
 // -----------------------------------------------------------------------------
-// PRE: ptrnodo1 y ptrnodo2 no pueden ser nulos
-// O(1)
-// POST: Intercambia los datos de dos nodos
+// O(n log r) siendo r el número de tramos ya ordenados
+// POST: Ordena los nodos a partir de cabeza por mezcla natural ascendente
+//       (iterativa y estable) y devuelve la nueva cabeza
+//       Si ptrcola no es nulo *ptrcola apunta al último nodo
 // -----------------------------------------------------------------------------
-void intercambiar (TNodoLista* ptrnodo1, TNodoLista* ptrnodo2)
+TNodoLista* ordenar_nodos (TNodoLista* cabeza, FComparar comparar, TNodoLista** ptrcola)
 {
-	TElemento aux;
+	TLlamada llamada = { comparar, NULL, NULL, NULL, NULL };
 	
-	aux = ptrnodo1->dato;
-	ptrnodo1->dato = ptrnodo2->dato;
-	ptrnodo2->dato = aux;
+	return ordenar_nodos_llamada (cabeza, &llamada, ptrcola);
 }
 
 
 // -----------------------------------------------------------------------------
-// PRE: n es la longitud de la sublista a ordenar
-// O(n^2)
-// POST: ordena la lista por el método de burbuja
+// O(n log n)
 // -----------------------------------------------------------------------------
-void burbuja(TLista* ptrlista, int n, FComparar comparar)
+void ordenar_lista (TLista* ptrlista, FComparar comparar)
 {
-	int i; 	// (i comparaciones -> i+1 elementos)
-	TNodoLista* ptrnodo;
+	EST_INICIO;
+	EST_CONTAR_COMPARAR (comparar);
 	
-	if (n<2)
-		return;
+	*ptrlista = ordenar_nodos(*ptrlista, comparar, NULL);
 	
-	ptrnodo = *ptrlista;
+	EST_FIN (EST_ORDENAR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log n)
+// -----------------------------------------------------------------------------
+void ordenar_vector (TElemento* v, TElemento* aux, size_t n, FComparar comparar)
+{
+	TElemento* origen;
+	TElemento* destino;
+	TElemento* tmp;
+	size_t ancho, inicio, medio, fin, i, j, k;
 	
-	// Realiza n-1 veces...
-	for (i=1; i<n; i++)
+	origen = v;
+	destino = aux;
+	for (ancho=1; ancho<n; ancho*=2)
 	{
-		// Si e1 > e2 los intercambia
-		if (comparar(ptrnodo->dato, ptrnodo->next->dato) > 0)
-			intercambiar (ptrnodo, ptrnodo->next);
-		
-		ptrnodo = ptrnodo->next;
+		for (inicio=0; inicio<n; inicio+=2*ancho)
+		{
+			medio = (inicio + ancho < n) ? inicio + ancho : n;
+			fin = (inicio + 2*ancho < n) ? inicio + 2*ancho : n;
+			i = inicio;
+			j = medio;
+			k = inicio;
+			while ((i < medio) && (j < fin))
+			{
+				if (comparar(origen[i], origen[j]) <= 0)
+					destino[k++] = origen[i++];
+				else
+					destino[k++] = origen[j++];
+			}
+			while (i < medio)
+				destino[k++] = origen[i++];
+			while (j < fin)
+				destino[k++] = origen[j++];
+		}
+		tmp = origen;
+		origen = destino;
+		destino = tmp;
 	}
-	burbuja(ptrlista, n-1, comparar);
-	return;
+	
+	if (origen != v)
+		memcpy (v, origen, n * sizeof(TElemento));
 }
 
 
 // -----------------------------------------------------------------------------
-// O(n^2)
+// O(n)
 // -----------------------------------------------------------------------------
-void ordenar_lista (TLista* ptrlista, FComparar comparar)
+void ordenar_lista_por_clave (TLista* ptrlista, FClave clave)
 {
-	int i;
+	TParClave* pares;
+	TParClave* aux;
+	TParClave* tmp;
+	TParClave* reserva;
 	TNodoLista* ptrnodo;
+	int (*cuentas)[256];
+	int i, n, b, byte, suma, c;
 	
-	if (es_lista_vacia(*ptrlista))
+	n = 0;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		n++;
+	if (n < 2)
 		return;
 	
-	ptrnodo = *ptrlista;
-			
-	if (ptrnodo->next == NULL)
-		return;
+	reserva = (TParClave*)malloc(2 * n * sizeof(TParClave));
+	pares = reserva;
+	aux = reserva + n;
+	cuentas = (int (*)[256])calloc(8, sizeof(*cuentas));
 	
-	i=0;
-	// La primera pasada se realiza aquí (para calcular la longitud)
-	while (ptrnodo->next != NULL)
+	// Una pasada saca las claves y cuenta los valores de sus 8 bytes
+	for (ptrnodo = *ptrlista, i = 0; ptrnodo != NULL; ptrnodo = ptrnodo->next, i++)
 	{
-		i++;			
-		// Si e1 > e2 los intercambia
-		if (comparar(ptrnodo->dato, ptrnodo->next->dato) > 0)
-			intercambiar (ptrnodo, ptrnodo->next);
-			
-		ptrnodo = ptrnodo->next;
+		pares[i].clave = clave (ptrnodo->dato);
+		pares[i].nodo = ptrnodo;
+		for (b=0; b<8; b++)
+			cuentas[b][(pares[i].clave >> (8 * b)) & 0xFF]++;
+	}
+	
+	// Radix LSD: cada pasada reparte por un byte de forma estable. Se saltan
+	// los bytes que valen lo mismo en todas las claves
+	for (b=0; b<8; b++)
+	{
+		if (cuentas[b][(pares[0].clave >> (8 * b)) & 0xFF] == n)
+			continue;
+		
+		// Las cuentas pasan a ser la primera posición de cada valor
+		suma = 0;
+		for (c=0; c<256; c++)
+		{
+			i = cuentas[b][c];
+			cuentas[b][c] = suma;
+			suma += i;
+		}
+		for (i=0; i<n; i++)
+		{
+			byte = (pares[i].clave >> (8 * b)) & 0xFF;
+			aux[cuentas[b][byte]++] = pares[i];
+		}
+		tmp = pares;
+		pares = aux;
+		aux = tmp;
 	}
-	// Las demás pasadas se realizan en burbuja
-	burbuja(ptrlista, i, comparar);
+	
+	for (i=0; i<n-1; i++)
+		pares[i].nodo->next = pares[i+1].nodo;
+	pares[n-1].nodo->next = NULL;
+	*ptrlista = pares[0].nodo;
+	
+	free (reserva);
+	free (cuentas);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+uint64_t clave_entero (int64_t v)
+{
+	// Al invertir el bit de signo los negativos quedan delante
+	return (uint64_t)v ^ 0x8000000000000000ULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+uint64_t clave_real (double v)
+{
+	uint64_t bits;
+	
+	// Positivos: basta poner el bit de signo. Negativos: se invierten todos
+	// los bits, porque en IEEE 754 una magnitud mayor da bits mayores
+	memcpy (&bits, &v, sizeof(bits));
+	if (bits & 0x8000000000000000ULL)
+		return ~bits;
+	return bits | 0x8000000000000000ULL;
 }
 
 
@@ -141,7 +551,56 @@ void ordenar_lista (TLista* ptrlista, FComparar comparar)
 // -----------------------------------------------------------------------------
 void insertar_elemento (TLista* ptrlista, TElemento e)
 {
-	*ptrlista = crear_nodo (e, *ptrlista);
+	insertar_elemento_pool (ptrlista, e, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+void insertar_elemento_pool (TLista* ptrlista, TElemento e, TPoolNodos* pool)
+{
+	EST_INICIO;
+	
+	*ptrlista = crear_nodo_pool (e, *ptrlista, pool);
+	
+	EST_NODOS (1);
+	EST_FIN (EST_INSERTAR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void insertar_lote_pool (TLista* ptrlista, TElemento* v, size_t n, TPoolNodos* pool)
+{
+	TNodoLista* ultimo;
+	EST_INICIO;
+	
+	*ptrlista = crear_cadena (v, n, 1, *ptrlista, pool, &ultimo);
+	
+	EST_NODOS (n);
+	EST_FIN (EST_INSERTAR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void insertar_lote (TLista* ptrlista, TElemento* v, size_t n)
+{
+	insertar_lote_pool (ptrlista, v, n, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+TLista crear_lista_desde_array (TElemento* v, size_t n, TPoolNodos* pool)
+{
+	TNodoLista* ultimo;
+	
+	return crear_cadena (v, n, 0, crear_lista_vacia(), pool, &ultimo);
 }
 
 
@@ -150,21 +609,35 @@ void insertar_elemento (TLista* ptrlista, TElemento e)
 // -----------------------------------------------------------------------------
 int buscar_elemento (TLista lista, TElemento e, FComparar comparar)
 {
-	TNodoLista* ptrnodo;
+	TLlamada llamada;
 	int n;
+	EST_INICIO;
+	EST_CONTAR_COMPARAR (comparar);
 	
-	if (lista == NULL)
-		return 0;
+	llamada.comparar = comparar;
+	n = buscar_elemento_llamada (lista, e, &llamada);
 	
-	ptrnodo = lista;
+	EST_FIN (EST_BUSCAR);
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n), la mitad en promedio para claves presentes
+// -----------------------------------------------------------------------------
+int buscar_elemento_ordenado (TLista lista, TElemento e, FComparar comparar)
+{
+	TNodoLista* ptrnodo;
+	int n, c;
 	
 	n = 0;
-	while (ptrnodo != NULL)
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
 	{
-		if (comparar(e, ptrnodo->dato) == 0)
+		c = comparar(e, ptrnodo->dato);
+		if (c < 0)
+			break;
+		if (c == 0)
 			n++;
-		
-		ptrnodo = ptrnodo->next;
 	}
 	return n;
 }
@@ -179,15 +652,21 @@ int buscar_elemento (TLista lista, TElemento e, FComparar comparar)
 TNodoLista** localizar_elemento (TNodoLista** inicial, TElemento e, FComparar comparar)
 {
 	TNodoLista* ptrnodo;
+	TNodoLista* adelantado;
 	TNodoLista** res;
 	TNodoLista** ptrptrnodo;
 	
 	res = NULL;
 	ptrnodo = *inicial;
 	ptrptrnodo = inicial;
+	adelantado = iniciar_prebusqueda (ptrnodo);
 	
 	while ((ptrnodo != NULL) && (res == NULL))
 	{
+		if (adelantado != NULL)
+			adelantado = avanzar_prebusqueda (adelantado);
+		
+		EST_NODOS (1);
 		if (comparar(e, ptrnodo->dato) == 0)
 			res = ptrptrnodo;
 		
@@ -200,71 +679,1238 @@ TNodoLista** localizar_elemento (TNodoLista** inicial, TElemento e, FComparar co
 
 
 // -----------------------------------------------------------------------------
-// POST: Elimina el nodo de la lista y devuelve un puntero al puntero que 
-//       apunta al siguiente elemento de la lista o NULL si no hay más o si
-//       se pasó un puntero nulo o el puntero que señala al elemento era nulo
+// O(posición de la primera coincidencia)
 // -----------------------------------------------------------------------------
-TNodoLista** quitar_nodo (TNodoLista** ptrptrnodo, FDestruir destruir)
+TNodoLista* encontrar_primero (TLista lista, TElemento e, FComparar comparar)
 {
-	TNodoLista* aux;
+	TLlamada llamada;
+	TNodoLista* ptrnodo;
+	EST_INICIO;
+	EST_CONTAR_COMPARAR (comparar);
 	
-	if (ptrptrnodo == NULL)
-		return NULL;
+	llamada.comparar = comparar;
+	ptrnodo = encontrar_primero_llamada (lista, e, &llamada);
 	
-	if (*ptrptrnodo == NULL)
-		return NULL;
-		
-	aux = *ptrptrnodo;
-	*ptrptrnodo = aux->next;
-	destruir (aux->dato);
-	free (aux);
-	return ptrptrnodo;
+	EST_FIN (EST_BUSCAR);
+	return ptrnodo;
 }
 
 
 // -----------------------------------------------------------------------------
-// O(n)
+// O(distancia hasta la siguiente coincidencia)
 // -----------------------------------------------------------------------------
-void borrar_elemento (TLista* ptrlista, TElemento e, int todos, FComparar comparar, FDestruir destruir)
+TNodoLista* encontrar_siguiente (TNodoLista* nodo, TElemento e, FComparar comparar)
 {
-	TNodoLista** ptrptrnodo;
-	
-	if (es_lista_vacia(*ptrlista))
-		return;
+	if (nodo == NULL)
+		return NULL;
 	
-	ptrptrnodo = ptrlista;
-	do
-	{
-		ptrptrnodo = localizar_elemento(ptrptrnodo, e, comparar);
-		ptrptrnodo = quitar_nodo (ptrptrnodo, destruir);
-	} 
-	while (todos && (ptrptrnodo != NULL));
+	return encontrar_primero (nodo->next, e, comparar);
 }
 
 
 // -----------------------------------------------------------------------------
-// O(n)
+// O(posición de la primera coincidencia), O(n) si no la hay
 // -----------------------------------------------------------------------------
-void destruir_lista (TLista* ptrlista, FDestruir destruir)
+int existe_elemento (TLista lista, TElemento e, FComparar comparar)
 {
-	while (!es_lista_vacia (*ptrlista))
+	return encontrar_primero (lista, e, comparar) != NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int contar_si (TLista lista, FPredicado cumple, void* contexto)
+{
+	TNodoLista* ptrnodo;
+	TNodoLista* adelantado;
+	int n;
+	EST_INICIO;
+	
+	n = 0;
+	ptrnodo = lista;
+	adelantado = iniciar_prebusqueda (ptrnodo);
+	while (ptrnodo != NULL)
 	{
-		quitar_nodo (ptrlista, destruir);
+		if (adelantado != NULL)
+			adelantado = avanzar_prebusqueda (adelantado);
+		
+		EST_NODOS (1);
+		if (cumple (ptrnodo->dato, contexto))
+			n++;
+		ptrnodo = ptrnodo->next;
 	}
+	
+	EST_FIN (EST_BUSCAR);
+	return n;
 }
 
 
 // -----------------------------------------------------------------------------
 // O(n)
 // -----------------------------------------------------------------------------
-TNodoLista* recorrer (TLista lista, FMap map)
+TLista filtrar (TLista lista, FPredicado cumple, void* contexto)
 {
+	TLista res;
+	TNodoLista** ptrptrfinal;
 	TNodoLista* ptrnodo;
+	TNodoLista* adelantado;
+	EST_INICIO;
 	
+	res = NULL;
+	ptrptrfinal = &res;
 	ptrnodo = lista;
+	adelantado = iniciar_prebusqueda (ptrnodo);
 	while (ptrnodo != NULL)
 	{
-		map (ptrnodo->dato);
+		if (adelantado != NULL)
+			adelantado = avanzar_prebusqueda (adelantado);
+		
+		EST_NODOS (1);
+		if (cumple (ptrnodo->dato, contexto))
+		{
+			*ptrptrfinal = crear_nodo (ptrnodo->dato, NULL);
+			ptrptrfinal = &((*ptrptrfinal)->next);
+		}
 		ptrnodo = ptrnodo->next;
 	}
+	
+	EST_FIN (EST_RECORRER);
+	return res;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el enlace que apunta al nodo de la posición pos (el next del
+//       último si la lista es más corta)
+// O(pos)
+// -----------------------------------------------------------------------------
+TNodoLista** enlace_en (TLista* ptrlista, int pos)
+{
+	TNodoLista** ptrptrnodo;
+	
+	ptrptrnodo = ptrlista;
+	while ((pos > 0) && (*ptrptrnodo != NULL))
+	{
+		ptrptrnodo = &((*ptrptrnodo)->next);
+		pos--;
+	}
+	return ptrptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(longitud de *lista)
+// -----------------------------------------------------------------------------
+void concatenar (TLista* ptrlista, TLista* ptrotra)
+{
+	TNodoLista** ptrptrnodo;
+	
+	ptrptrnodo = ptrlista;
+	while (*ptrptrnodo != NULL)
+		ptrptrnodo = &((*ptrptrnodo)->next);
+	
+	*ptrptrnodo = *ptrotra;
+	*ptrotra = NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(pos)
+// -----------------------------------------------------------------------------
+TLista dividir_en (TLista* ptrlista, int pos)
+{
+	TNodoLista** ptrptrnodo;
+	TLista resto;
+	
+	ptrptrnodo = enlace_en (ptrlista, pos);
+	resto = *ptrptrnodo;
+	*ptrptrnodo = NULL;
+	
+	return resto;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+TLista partir_por_predicado (TLista* ptrlista, FPredicado cumple, void* contexto)
+{
+	TLista resto;
+	TNodoLista** ptrptrsi;
+	TNodoLista** ptrptrno;
+	TNodoLista* ptrnodo;
+	
+	resto = NULL;
+	ptrptrsi = ptrlista;
+	ptrptrno = &resto;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		if (cumple (ptrnodo->dato, contexto))
+		{
+			*ptrptrsi = ptrnodo;
+			ptrptrsi = &(ptrnodo->next);
+		}
+		else
+		{
+			*ptrptrno = ptrnodo;
+			ptrptrno = &(ptrnodo->next);
+		}
+	}
+	*ptrptrsi = NULL;
+	*ptrptrno = NULL;
+	
+	return resto;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void invertir (TLista* ptrlista)
+{
+	TNodoLista* invertida;
+	TNodoLista* ptrnodo;
+	TNodoLista* sig;
+	
+	invertida = NULL;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = sig)
+	{
+		sig = ptrnodo->next;
+		ptrnodo->next = invertida;
+		invertida = ptrnodo;
+	}
+	*ptrlista = invertida;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(desde + n + pos)
+// -----------------------------------------------------------------------------
+int mover_rango (TLista* origen, int desde, int n, TLista* destino, int pos)
+{
+	TNodoLista** ptrptrinicio;
+	TNodoLista** ptrptrdestino;
+	TNodoLista* primero;
+	TNodoLista* ultimo;
+	int movidos;
+	
+	ptrptrinicio = enlace_en (origen, desde);
+	primero = *ptrptrinicio;
+	if ((primero == NULL) || (n < 1))
+		return 0;
+	
+	ultimo = primero;
+	for (movidos = 1; (movidos < n) && (ultimo->next != NULL); movidos++)
+		ultimo = ultimo->next;
+	
+	*ptrptrinicio = ultimo->next;
+	ptrptrdestino = enlace_en (destino, pos);
+	ultimo->next = *ptrptrdestino;
+	*ptrptrdestino = primero;
+	
+	return movidos;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Elimina el nodo de la lista y devuelve un puntero al puntero que 
+//       apunta al siguiente elemento de la lista o NULL si no hay más o si
+//       se pasó un puntero nulo o el puntero que señala al elemento era nulo
+//       El nodo se devuelve a pool (o se libera si pool es nulo)
+// -----------------------------------------------------------------------------
+TNodoLista** quitar_nodo_pool (TNodoLista** ptrptrnodo, FDestruir destruir, TPoolNodos* pool)
+{
+	TNodoLista* aux;
+	
+	if (ptrptrnodo == NULL)
+		return NULL;
+	
+	if (*ptrptrnodo == NULL)
+		return NULL;
+		
+	aux = *ptrptrnodo;
+	*ptrptrnodo = aux->next;
+	destruir (aux->dato);
+	liberar_nodo (aux, pool);
+	return ptrptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Igual que quitar_nodo_pool para nodos creados con malloc
+// -----------------------------------------------------------------------------
+TNodoLista** quitar_nodo (TNodoLista** ptrptrnodo, FDestruir destruir)
+{
+	return quitar_nodo_pool (ptrptrnodo, destruir, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita el primer nodo que coincide con e (o todos si todos!=0)
+//       devolviendo los nodos a pool y el número de nodos quitados
+// O(n)
+// -----------------------------------------------------------------------------
+int quitar_coincidencias (TLista* ptrlista, TElemento e, int todos, FComparar comparar, FDestruir destruir, TPoolNodos* pool)
+{
+	TNodoLista** ptrptrnodo;
+	int n;
+	
+	n = 0;
+	ptrptrnodo = ptrlista;
+	while (ptrptrnodo != NULL)
+	{
+		ptrptrnodo = localizar_elemento(ptrptrnodo, e, comparar);
+		ptrptrnodo = quitar_nodo_pool (ptrptrnodo, destruir, pool);
+		if (ptrptrnodo != NULL)
+			n++;
+		if (!todos)
+			break;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void borrar_elemento_pool (TLista* ptrlista, TElemento e, int todos, FComparar comparar, FDestruir destruir, TPoolNodos* pool)
+{
+	EST_INICIO;
+	EST_CONTAR_COMPARAR (comparar);
+	EST_CONTAR_DESTRUIR (destruir);
+	
+	quitar_coincidencias (ptrlista, e, todos, comparar, destruir, pool);
+	
+	EST_FIN (EST_BORRAR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void borrar_elemento (TLista* ptrlista, TElemento e, int todos, FComparar comparar, FDestruir destruir)
+{
+	borrar_elemento_pool (ptrlista, e, todos, comparar, destruir, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: claves ordenado según comparar
+// POST: Devuelve la posición de la primera clave igual a e o -1 si no hay
+// O(log k)
+// -----------------------------------------------------------------------------
+ptrdiff_t buscar_clave (TElemento* claves, size_t k, TElemento e, FComparar comparar)
+{
+	size_t ini, fin, medio;
+	
+	// Primera posición cuya clave no es menor que e
+	ini = 0;
+	fin = k;
+	while (ini < fin)
+	{
+		medio = ini + (fin - ini) / 2;
+		if (comparar(claves[medio], e) < 0)
+			ini = medio + 1;
+		else
+			fin = medio;
+	}
+	
+	if ((ini < k) && (comparar(claves[ini], e) == 0))
+		return (ptrdiff_t)ini;
+	return -1;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve una copia ordenada de las k claves (hay que liberarla)
+// O(k log k)
+// -----------------------------------------------------------------------------
+TElemento* ordenar_claves (TElemento* claves, size_t k, FComparar comparar)
+{
+	TElemento* v;
+	
+	v = (TElemento*)malloc(2 * k * sizeof(TElemento));
+	memcpy (v, claves, k * sizeof(TElemento));
+	ordenar_vector (v, v + k, k, comparar);
+	return v;
+}
+
+
+// -----------------------------------------------------------------------------
+// O((n + k) log k)
+// -----------------------------------------------------------------------------
+int contar_elementos_lote (TLista lista, TElemento* claves, size_t k, FComparar comparar, int* cuentas)
+{
+	TNodoLista* ptrnodo;
+	TElemento* ordenadas;
+	int* parcial;
+	ptrdiff_t j;
+	size_t i;
+	int n;
+	
+	if (k == 0)
+		return 0;
+	
+	ordenadas = ordenar_claves (claves, k, comparar);
+	parcial = (int*)calloc(k, sizeof(int));
+	
+	n = 0;
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		j = buscar_clave (ordenadas, k, ptrnodo->dato, comparar);
+		if (j >= 0)
+		{
+			parcial[j]++;
+			n++;
+		}
+	}
+	
+	// Cada clave toma la cuenta de su primera igual en el vector ordenado
+	if (cuentas != NULL)
+	{
+		for (i=0; i<k; i++)
+			cuentas[i] = parcial[buscar_clave (ordenadas, k, claves[i], comparar)];
+	}
+	
+	free (parcial);
+	free (ordenadas);
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita todos los nodos que coinciden con alguna de las k claves,
+//       devolviéndolos a pool, y devuelve cuántos quitó
+//       *ptrultimo apunta al último nodo que queda (NULL si ninguno)
+// O((n + k) log k)
+// -----------------------------------------------------------------------------
+int quitar_coincidencias_lote (TLista* ptrlista, TElemento* claves, size_t k, FComparar comparar, FDestruir destruir, TPoolNodos* pool, TNodoLista** ptrultimo)
+{
+	TNodoLista** ptrptrnodo;
+	TElemento* ordenadas;
+	int n;
+	
+	*ptrultimo = NULL;
+	if (k == 0)
+	{
+		for (ptrptrnodo = ptrlista; *ptrptrnodo != NULL; ptrptrnodo = &((*ptrptrnodo)->next))
+			*ptrultimo = *ptrptrnodo;
+		return 0;
+	}
+	
+	ordenadas = ordenar_claves (claves, k, comparar);
+	
+	n = 0;
+	ptrptrnodo = ptrlista;
+	while (*ptrptrnodo != NULL)
+	{
+		if (buscar_clave (ordenadas, k, (*ptrptrnodo)->dato, comparar) >= 0)
+		{
+			quitar_nodo_pool (ptrptrnodo, destruir, pool);
+			n++;
+		}
+		else
+		{
+			*ptrultimo = *ptrptrnodo;
+			ptrptrnodo = &((*ptrptrnodo)->next);
+		}
+	}
+	
+	free (ordenadas);
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O((n + k) log k)
+// -----------------------------------------------------------------------------
+int borrar_elementos_lote (TLista* ptrlista, TElemento* claves, size_t k, FComparar comparar, FDestruir destruir)
+{
+	TNodoLista* ultimo;
+	
+	return quitar_coincidencias_lote (ptrlista, claves, k, comparar, destruir, NULL, &ultimo);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_lista (TLista* ptrlista, FDestruir destruir)
+{
+	EST_INICIO;
+	EST_CONTAR_DESTRUIR (destruir);
+	
+	while (!es_lista_vacia (*ptrlista))
+	{
+		EST_NODOS (1);
+		quitar_nodo (ptrlista, destruir);
+	}
+	
+	EST_FIN (EST_DESTRUIR);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el número de nodos de la lista
+// O(n)
+// -----------------------------------------------------------------------------
+int contar_nodos (TLista lista)
+{
+	int n;
+	
+	for (n = 0; lista != NULL; lista = lista->next)
+		n++;
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea un índice con sitio para los nodos de la lista, de modo que
+//       llenarlo no reserva memoria por cada nodo
+// O(n)
+// -----------------------------------------------------------------------------
+TIndiceHash* nuevo_indice_lista (TLista lista, FComparar comparar, FHash hash)
+{
+	TIndiceHash* indice;
+	
+	indice = nuevo_indice (hash, comparar);
+	indice_reservar (indice, contar_nodos (lista));
+	return indice;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: otra es NULL o un índice de los elementos de la otra lista
+// POST: Quita de la lista los elementos repetidos y, si hay otra, los que
+//       están en ella (en_otra == 0) o los que no están (en_otra != 0)
+//       Los nodos quitados se devuelven a pool (o se liberan si es nulo)
+//       Devuelve el número de elementos quitados
+// O(n) esperado
+// -----------------------------------------------------------------------------
+int filtrar_conjunto_hash (TLista* ptrlista, TIndiceHash* otra, int en_otra,
+                           FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool)
+{
+	TIndiceHash* vistos;
+	TNodoLista** ptrptrnodo;
+	TNodoLista* ptrnodo;
+	int n;
+	
+	n = 0;
+	vistos = nuevo_indice_lista (*ptrlista, comparar, hash);
+	ptrptrnodo = ptrlista;
+	while ((ptrnodo = *ptrptrnodo) != NULL)
+	{
+		if ((indice_contar (vistos, ptrnodo->dato) == 0) &&
+		    ((otra == NULL) || ((indice_contar (otra, ptrnodo->dato) > 0) == (en_otra != 0))))
+		{
+			indice_anadir (vistos, ptrnodo, NULL, 0);
+			ptrptrnodo = &(ptrnodo->next);
+		}
+		else
+		{
+			quitar_nodo_pool (ptrptrnodo, destruir, pool);
+			n++;
+		}
+	}
+	liberar_indice (vistos);
+	
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: La lista y la otra (si no es nula) están ordenadas según comparar
+// POST: Como filtrar_conjunto_hash recorriendo las dos listas a la par
+//       Con en_otra < 0 sólo quita los repetidos (otra no se mira)
+// O(n + m)
+// -----------------------------------------------------------------------------
+int filtrar_conjunto_ordenado (TLista* ptrlista, TLista otra, int en_otra,
+                               FComparar comparar, FDestruir destruir, TPoolNodos* pool)
+{
+	TNodoLista** ptrptrnodo;
+	TNodoLista* ptrnodo;
+	TNodoLista* anterior;
+	int n, esta;
+	
+	n = 0;
+	anterior = NULL;
+	ptrptrnodo = ptrlista;
+	while ((ptrnodo = *ptrptrnodo) != NULL)
+	{
+		// Los repetidos quedan juntos: basta comparar con el último que se quedó
+		if ((anterior != NULL) && (comparar (anterior->dato, ptrnodo->dato) == 0))
+		{
+			quitar_nodo_pool (ptrptrnodo, destruir, pool);
+			n++;
+			continue;
+		}
+		
+		while ((otra != NULL) && (comparar (otra->dato, ptrnodo->dato) < 0))
+			otra = otra->next;
+		esta = (otra != NULL) && (comparar (otra->dato, ptrnodo->dato) == 0);
+		
+		if ((en_otra < 0) || (esta == (en_otra != 0)))
+		{
+			anterior = ptrnodo;
+			ptrptrnodo = &(ptrnodo->next);
+		}
+		else
+		{
+			quitar_nodo_pool (ptrptrnodo, destruir, pool);
+			n++;
+		}
+	}
+	
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita de *a los repetidos y los que están en *b (en_otra == 0) o no
+//       están (en_otra != 0), devolviendo sus nodos a pool
+// -----------------------------------------------------------------------------
+int operar_conjuntos (TLista* a, TLista* b, int en_otra, FComparar comparar, FHash hash,
+                      FDestruir destruir, TPoolNodos* pool)
+{
+	TIndiceHash* otra;
+	TNodoLista* ptrnodo;
+	int n;
+	
+	if (hash == NULL)
+	{
+		ordenar_lista (a, comparar);
+		ordenar_lista (b, comparar);
+		return filtrar_conjunto_ordenado (a, *b, en_otra, comparar, destruir, pool);
+	}
+	
+	// Basta un nodo por clave de b para saber si está
+	otra = nuevo_indice_lista (*b, comparar, hash);
+	for (ptrnodo = *b; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		if (indice_contar (otra, ptrnodo->dato) == 0)
+			indice_anadir (otra, ptrnodo, NULL, 0);
+	}
+	n = filtrar_conjunto_hash (a, otra, en_otra, comparar, hash, destruir, pool);
+	liberar_indice (otra);
+	
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n) esperado con hash, O(n log n) sin él
+// -----------------------------------------------------------------------------
+int eliminar_duplicados_pool (TLista* ptrlista, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool)
+{
+	if (hash != NULL)
+		return filtrar_conjunto_hash (ptrlista, NULL, 0, comparar, hash, destruir, pool);
+	
+	ordenar_lista (ptrlista, comparar);
+	return filtrar_conjunto_ordenado (ptrlista, NULL, -1, comparar, destruir, pool);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n + m) esperado con hash, O((n + m) log (n + m)) sin él
+// -----------------------------------------------------------------------------
+int union_listas_pool (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool)
+{
+	concatenar (a, b);
+	return eliminar_duplicados_pool (a, comparar, hash, destruir, pool);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n + m) esperado con hash, O(n log n + m log m) sin él
+// -----------------------------------------------------------------------------
+int interseccion_listas_pool (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool)
+{
+	return operar_conjuntos (a, b, 1, comparar, hash, destruir, pool);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n + m) esperado con hash, O(n log n + m log m) sin él
+// -----------------------------------------------------------------------------
+int diferencia_listas_pool (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool)
+{
+	return operar_conjuntos (a, b, 0, comparar, hash, destruir, pool);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n) esperado con hash, O(n log n) sin él
+// -----------------------------------------------------------------------------
+int eliminar_duplicados (TLista* ptrlista, FComparar comparar, FHash hash, FDestruir destruir)
+{
+	return eliminar_duplicados_pool (ptrlista, comparar, hash, destruir, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n + m) esperado con hash, O((n + m) log (n + m)) sin él
+// -----------------------------------------------------------------------------
+int union_listas (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir)
+{
+	return union_listas_pool (a, b, comparar, hash, destruir, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n + m) esperado con hash, O(n log n + m log m) sin él
+// -----------------------------------------------------------------------------
+int interseccion_listas (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir)
+{
+	return interseccion_listas_pool (a, b, comparar, hash, destruir, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n + m) esperado con hash, O(n log n + m log m) sin él
+// -----------------------------------------------------------------------------
+int diferencia_listas (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir)
+{
+	return diferencia_listas_pool (a, b, comparar, hash, destruir, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log n)
+// -----------------------------------------------------------------------------
+void ordenar_lista_ctx (TLista* ptrlista, FCompararCtx comparar, void* contexto)
+{
+	TLlamada llamada = { NULL, NULL, comparar, NULL, contexto };
+	EST_INICIO;
+	
+	ordenar_lista_llamada_ctx (ptrlista, &llamada);
+	
+	EST_FIN (EST_ORDENAR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int buscar_elemento_ctx (TLista lista, TElemento e, FCompararCtx comparar, void* contexto)
+{
+	TLlamada llamada = { NULL, NULL, comparar, NULL, contexto };
+	int n;
+	EST_INICIO;
+	
+	n = buscar_elemento_llamada_ctx (lista, e, &llamada);
+	
+	EST_FIN (EST_BUSCAR);
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(posición de la primera coincidencia)
+// -----------------------------------------------------------------------------
+TNodoLista* encontrar_primero_ctx (TLista lista, TElemento e, FCompararCtx comparar, void* contexto)
+{
+	TLlamada llamada = { NULL, NULL, comparar, NULL, contexto };
+	TNodoLista* ptrnodo;
+	EST_INICIO;
+	
+	ptrnodo = encontrar_primero_llamada_ctx (lista, e, &llamada);
+	
+	EST_FIN (EST_BUSCAR);
+	return ptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(distancia hasta la siguiente coincidencia)
+// -----------------------------------------------------------------------------
+TNodoLista* encontrar_siguiente_ctx (TNodoLista* nodo, TElemento e, FCompararCtx comparar, void* contexto)
+{
+	if (nodo == NULL)
+		return NULL;
+	
+	return encontrar_primero_ctx (nodo->next, e, comparar, contexto);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(posición de la primera coincidencia), O(n) si no la hay
+// -----------------------------------------------------------------------------
+int existe_elemento_ctx (TLista lista, TElemento e, FCompararCtx comparar, void* contexto)
+{
+	return encontrar_primero_ctx (lista, e, comparar, contexto) != NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void recorrer_ctx (TLista lista, FMapCtx map, void* contexto)
+{
+	TLlamada llamada = { NULL, NULL, NULL, map, contexto };
+	EST_INICIO;
+	
+	recorrer_llamada_ctx (lista, &llamada);
+	
+	EST_FIN (EST_RECORRER);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void borrar_elemento_ctx (TLista* ptrlista, TElemento e, int todos, FCompararCtx comparar,
+                          FDestruirCtx destruir, void* contexto)
+{
+	TNodoLista** ptrptrnodo;
+	TNodoLista* ptrnodo;
+	EST_INICIO;
+	
+	ptrptrnodo = ptrlista;
+	while ((ptrnodo = *ptrptrnodo) != NULL)
+	{
+		EST_NODOS (1);
+		if (comparar (e, ptrnodo->dato, contexto) != 0)
+		{
+			ptrptrnodo = &(ptrnodo->next);
+			continue;
+		}
+		
+		*ptrptrnodo = ptrnodo->next;
+		destruir (ptrnodo->dato, contexto);
+		liberar_nodo (ptrnodo, NULL);
+		if (!todos)
+			break;
+	}
+	
+	EST_FIN (EST_BORRAR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_lista_ctx (TLista* ptrlista, FDestruirCtx destruir, void* contexto)
+{
+	TNodoLista* ptrnodo;
+	EST_INICIO;
+	
+	while (*ptrlista != NULL)
+	{
+		EST_NODOS (1);
+		ptrnodo = *ptrlista;
+		*ptrlista = ptrnodo->next;
+		destruir (ptrnodo->dato, contexto);
+		liberar_nodo (ptrnodo, NULL);
+	}
+	
+	EST_FIN (EST_DESTRUIR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n) para destruir los elementos, los nodos se liberan por bloques
+// -----------------------------------------------------------------------------
+void destruir_lista_pool (TLista* ptrlista, FDestruir destruir, TPoolNodos* pool)
+{
+	TNodoLista* ptrnodo;
+	EST_INICIO;
+	EST_CONTAR_DESTRUIR (destruir);
+	
+	ptrnodo = *ptrlista;
+	while (ptrnodo != NULL)
+	{
+		EST_NODOS (1);
+		destruir (ptrnodo->dato);
+		ptrnodo = ptrnodo->next;
+	}
+	*ptrlista = crear_lista_vacia();
+	vaciar_pool_nodos (pool);
+	
+	EST_FIN (EST_DESTRUIR);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+TCompactacion iniciar_compactacion (TLista* ptrlista, TPoolNodos* pool)
+{
+	TCompactacion compactacion;
+	TNodoLista* ptrnodo;
+	int n;
+	
+	n = 0;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		n++;
+	
+	// El pool nuevo tiene bloques del tamaño normal para las inserciones que
+	// vengan después; la lista va en un solo bloque propio si no cabe en uno
+	compactacion.pendiente = ptrlista;
+	compactacion.restantes = n;
+	compactacion.origen = pool;
+	compactacion.destino = crear_pool_nodos ((pool != NULL) ? pool->nodos_por_bloque : 0);
+	compactacion.nuevos = (n > 0) ? reservar_nodos_pool (compactacion.destino, n) : NULL;
+	
+	return compactacion;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int compactar_pasos (TCompactacion* compactacion, int n)
+{
+	TNodoLista* viejo;
+	TNodoLista* nuevo;
+	
+	while ((n > 0) && (compactacion->restantes > 0))
+	{
+		viejo = *(compactacion->pendiente);
+		nuevo = compactacion->nuevos++;
+		nuevo->dato = viejo->dato;
+		nuevo->next = viejo->next;
+		*(compactacion->pendiente) = nuevo;
+		liberar_nodo (viejo, compactacion->origen);
+		
+		compactacion->pendiente = &(nuevo->next);
+		compactacion->restantes--;
+		n--;
+	}
+	
+	// Ya no queda ningún nodo de la lista en el pool viejo: sus bloques sobran
+	if ((compactacion->restantes == 0) && (compactacion->origen != NULL))
+		vaciar_pool_nodos (compactacion->origen);
+	return compactacion->restantes;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+TPoolNodos* compactar_lista (TLista* ptrlista, TPoolNodos* pool)
+{
+	TCompactacion compactacion;
+	
+	compactacion = iniciar_compactacion (ptrlista, pool);
+	compactar_pasos (&compactacion, compactacion.restantes);
+	return compactacion.destino;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+TNodoLista* recorrer (TLista lista, FMap map)
+{
+	TLlamada llamada;
+	EST_INICIO;
+	
+	llamada.map = map;
+	recorrer_llamada (lista, &llamada);
+	
+	EST_FIN (EST_RECORRER);
+	return NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Añade al índice los nodos desde primero hasta fin (sin incluirlo) con
+//       órdenes consecutivos a partir de orden, y cambia el enlace de fin
+// O(n) esperado
+// -----------------------------------------------------------------------------
+void indexar_cadena (TIndiceHash* indice, TNodoLista* primero, TNodoLista* fin, long long orden)
+{
+	TNodoLista** enlace;
+	TNodoLista* ptrnodo;
+	
+	// El primer nodo de la cadena es el primero de la lista
+	enlace = NULL;
+	for (ptrnodo = primero; ptrnodo != fin; ptrnodo = ptrnodo->next)
+	{
+		indice_anadir (indice, ptrnodo, enlace, orden++);
+		enlace = &(ptrnodo->next);
+	}
+	if (fin != NULL)
+		indice_cambiar_enlace (indice, fin, enlace);
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: cab->indice no es nulo
+// POST: Igual que borrar_elemento_cab buscando los nodos en el índice y
+//       devuelve el número de nodos quitados
+// O(1 + ocurrencias) esperado
+// -----------------------------------------------------------------------------
+int borrar_por_indice (TCabecera* cab, TElemento e, int todos, FDestruir destruir)
+{
+	TNodoLista** enlace;
+	TNodoLista* ptrnodo;
+	int n;
+	
+	n = 0;
+	// Un borrado simple debe quitar la primera coincidencia de la lista
+	while ((ptrnodo = indice_buscar (cab->indice, e, !todos, &enlace)) != NULL)
+	{
+		if (enlace == NULL)
+			cab->cabeza = ptrnodo->next;
+		else
+			*enlace = ptrnodo->next;
+		
+		if (ptrnodo->next != NULL)
+			indice_cambiar_enlace (cab->indice, ptrnodo->next, enlace);
+		else if (enlace == NULL)
+			cab->cola = NULL;
+		else
+			cab->cola = (TNodoLista*)((char*)enlace - offsetof(TNodoLista, next));
+		
+		indice_quitar (cab->indice, ptrnodo);
+		destruir (ptrnodo->dato);
+		liberar_nodo (ptrnodo, cab->pool);
+		cab->longitud--;
+		n++;
+		if (!todos)
+			break;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TCabecera crear_cabecera_vacia (void)
+{
+	return crear_cabecera_con_pool (NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TCabecera crear_cabecera_con_pool (TPoolNodos* pool)
+{
+	TCabecera cab;
+	
+	cab.cabeza = crear_lista_vacia();
+	cab.cola = NULL;
+	cab.longitud = 0;
+	cab.pool = pool;
+	cab.indice = NULL;
+	
+	return cab;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+int longitud (TCabecera* cab)
+{
+	return cab->longitud;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+void insertar_cabeza (TCabecera* cab, TElemento e)
+{
+	cab->cabeza = crear_nodo_pool (e, cab->cabeza, cab->pool);
+	if (cab->indice != NULL)
+	{
+		if (cab->cabeza->next != NULL)
+			indice_cambiar_enlace (cab->indice, cab->cabeza->next, &(cab->cabeza->next));
+		indice_anadir (cab->indice, cab->cabeza, NULL, indice_orden_cabeza (cab->indice, 1));
+	}
+	if (cab->cola == NULL)
+		cab->cola = cab->cabeza;
+	cab->longitud++;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+void insertar_final (TCabecera* cab, TElemento e)
+{
+	TNodoLista* ptrnodo;
+	
+	ptrnodo = crear_nodo_pool (e, NULL, cab->pool);
+	if (cab->indice != NULL)
+		indice_anadir (cab->indice, ptrnodo, (cab->cola != NULL) ? &(cab->cola->next) : NULL,
+		               indice_orden_cola (cab->indice));
+	if (cab->cola == NULL)
+		cab->cabeza = ptrnodo;
+	else
+		cab->cola->next = ptrnodo;
+	cab->cola = ptrnodo;
+	cab->longitud++;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void insertar_lote_cab (TCabecera* cab, TElemento* v, size_t n)
+{
+	TNodoLista* ultimo;
+	
+	if (n == 0)
+		return;
+	
+	cab->cabeza = crear_cadena (v, n, 1, cab->cabeza, cab->pool, &ultimo);
+	if (cab->indice != NULL)
+		indexar_cadena (cab->indice, cab->cabeza, ultimo->next, indice_orden_cabeza (cab->indice, (int)n));
+	if (cab->cola == NULL)
+		cab->cola = ultimo;
+	cab->longitud += (int)n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TElemento extraer_primero (TCabecera* cab)
+{
+	TNodoLista* ptrnodo;
+	TElemento e;
+	
+	if (es_lista_vacia (cab->cabeza))
+		return NULL;
+	
+	ptrnodo = cab->cabeza;
+	e = ptrnodo->dato;
+	cab->cabeza = ptrnodo->next;
+	if (cab->cabeza == NULL)
+		cab->cola = NULL;
+	cab->longitud--;
+	if (cab->indice != NULL)
+	{
+		indice_quitar (cab->indice, ptrnodo);
+		if (cab->cabeza != NULL)
+			indice_cambiar_enlace (cab->indice, cab->cabeza, NULL);
+	}
+	liberar_nodo (ptrnodo, cab->pool);
+	
+	return e;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void borrar_elemento_cab (TCabecera* cab, TElemento e, int todos, FComparar comparar, FDestruir destruir)
+{
+	TNodoLista* ptrnodo;
+	int cola_afectada;
+	
+	if (es_lista_vacia (cab->cabeza))
+		return;
+	
+	if (cab->indice != NULL)
+	{
+		borrar_por_indice (cab, e, todos, destruir);
+		return;
+	}
+	
+	// Sólo hay que buscar la nueva cola si la actual puede desaparecer
+	cola_afectada = (comparar(e, cab->cola->dato) == 0);
+	cab->longitud -= quitar_coincidencias (&(cab->cabeza), e, todos, comparar, destruir, cab->pool);
+	
+	if (cola_afectada)
+	{
+		ptrnodo = cab->cabeza;
+		while ((ptrnodo != NULL) && (ptrnodo->next != NULL))
+			ptrnodo = ptrnodo->next;
+		cab->cola = ptrnodo;
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O((n + k) log k)
+// -----------------------------------------------------------------------------
+int borrar_elementos_lote_cab (TCabecera* cab, TElemento* claves, size_t k, FComparar comparar, FDestruir destruir)
+{
+	size_t i;
+	int n;
+	
+	if (cab->indice != NULL)
+	{
+		n = 0;
+		for (i=0; i<k; i++)
+			n += borrar_por_indice (cab, claves[i], 1, destruir);
+		return n;
+	}
+	
+	n = quitar_coincidencias_lote (&(cab->cabeza), claves, k, comparar, destruir, cab->pool, &(cab->cola));
+	cab->longitud -= n;
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log n)
+// -----------------------------------------------------------------------------
+void ordenar_lista_cab (TCabecera* cab, FComparar comparar)
+{
+	cab->cabeza = ordenar_nodos (cab->cabeza, comparar, &(cab->cola));
+	
+	// Todos los enlaces han cambiado
+	if (cab->indice != NULL)
+	{
+		vaciar_indice (cab->indice);
+		indexar_cadena (cab->indice, cab->cabeza, NULL, indice_orden_cabeza (cab->indice, cab->longitud));
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_lista_cab (TCabecera* cab, FDestruir destruir)
+{
+	if (cab->pool != NULL)
+		destruir_lista_pool (&(cab->cabeza), destruir, cab->pool);
+	else
+		destruir_lista (&(cab->cabeza), destruir);
+	
+	if (cab->indice != NULL)
+		vaciar_indice (cab->indice);
+	cab->cola = NULL;
+	cab->longitud = 0;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1 + ocurrencias) esperado con índice, O(n) sin él
+// -----------------------------------------------------------------------------
+int buscar_elemento_cab (TCabecera* cab, TElemento e, FComparar comparar)
+{
+	if (cab->indice != NULL)
+		return indice_contar (cab->indice, e);
+	
+	return buscar_elemento (cab->cabeza, e, comparar);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void crear_indice_hash (TCabecera* cab, FHash hash, FComparar comparar)
+{
+	liberar_indice (cab->indice);
+	cab->indice = nuevo_indice (hash, comparar);
+	indexar_cadena (cab->indice, cab->cabeza, NULL, indice_orden_cabeza (cab->indice, cab->longitud));
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_indice_hash (TCabecera* cab)
+{
+	liberar_indice (cab->indice);
+	cab->indice = NULL;
 }
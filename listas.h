@@ -20,6 +20,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#ifndef LISTAS_H
+#define LISTAS_H
+
+#include <stddef.h>
+#include <stdint.h>
 
 // -----------------------------------------------------------------------------
 // Para hacer más legible el código
@@ -34,6 +39,33 @@ typedef struct list
 
 typedef TNodoLista* TLista;
 
+// Pool de nodos opcional para evitar un malloc/free por nodo
+typedef struct pool_nodos TPoolNodos;
+
+// Estado de una compactación incremental (ver iniciar_compactacion)
+typedef struct compactacion
+{
+	TNodoLista** pendiente;     // enlace al primer nodo aún sin mover
+	TNodoLista*  nuevos;        // siguiente hueco libre del bloque nuevo
+	int          restantes;     // nodos que faltan por mover
+	TPoolNodos*  origen;        // de donde salieron los nodos, NULL si malloc
+	TPoolNodos*  destino;       // pool con el bloque nuevo
+} TCompactacion;
+
+// Índice hash opcional de una lista con cabecera
+typedef struct indice_hash TIndiceHash;
+
+// Cabecera de lista: conoce el primer y el último nodo y la longitud
+// cabeza es una TLista normal, se puede pasar a buscar_elemento o recorrer
+typedef struct cabecera
+{
+	TLista      cabeza;
+	TNodoLista* cola;
+	int         longitud;
+	TPoolNodos* pool;       // NULL si los nodos se reservan con malloc
+	TIndiceHash* indice;    // NULL si no se ha creado índice
+} TCabecera;
+
 // -----------------------------------------------------------------------------
 // Puntero a función utilizada para comparar dos elementos
 // POST: devuelve  0 (cero)     si e1 = e2
@@ -52,6 +84,34 @@ typedef void (*FMap) (TElemento e);
 // -----------------------------------------------------------------------------
 typedef void (*FDestruir) (TElemento e);
 
+// -----------------------------------------------------------------------------
+// Puntero a función de hash para el índice de una lista con cabecera
+// POST: comparar(e1, e2) == 0 => hash(e1) == hash(e2)
+// -----------------------------------------------------------------------------
+typedef unsigned int (*FHash) (TElemento e);
+
+// -----------------------------------------------------------------------------
+// Puntero a función que devuelve la clave numérica de un elemento
+// POST: clave(e1) < clave(e2) <=> e1 va antes que e2
+// -----------------------------------------------------------------------------
+typedef uint64_t (*FClave) (TElemento e);
+
+// -----------------------------------------------------------------------------
+// Puntero a función que decide si un elemento cumple una condición
+// contexto es el puntero que se pasó junto a la función (puede ser NULL)
+// POST: devuelve distinto de cero si e la cumple
+// -----------------------------------------------------------------------------
+typedef int (*FPredicado) (TElemento e, void* contexto);
+
+// -----------------------------------------------------------------------------
+// Versiones de FComparar, FMap y FDestruir con contexto, para las operaciones
+// _ctx: reciben el puntero que se pasó a la operación (puede ser NULL), así
+// los parámetros de la comparación no tienen que estar en variables globales
+// -----------------------------------------------------------------------------
+typedef int (*FCompararCtx) (TElemento e1, TElemento e2, void* contexto);
+typedef void (*FMapCtx) (TElemento e, void* contexto);
+typedef void (*FDestruirCtx) (TElemento e, void* contexto);
+
 
 
 
@@ -70,12 +130,37 @@ int es_lista_vacia (TLista lista);
 
 // -----------------------------------------------------------------------------
 // POST: Ordena la lista utilizando para ello la función pasada como parámetro
+//       La ordenación es estable (los iguales conservan su orden relativo)
+//       y reenlaza los nodos, no intercambia los datos
 //       ordenar_lista(crear_lista_vacia) = crear_lista_vacia
 //       ordenar_lista([e1, e2, e3]) = [e2, e3, e1] <=> 
 //          comparar(e2, e3) < 0 Y comparar(e3, e1) < 0 Y comparar(e2, e1) < 0
 // -----------------------------------------------------------------------------
 void ordenar_lista (TLista* lista, FComparar comparar);
 
+// -----------------------------------------------------------------------------
+// PRE: aux tiene sitio para n elementos
+// POST: Ordena el vector v de n elementos con comparar (mezcla estable)
+// -----------------------------------------------------------------------------
+void ordenar_vector (TElemento* v, TElemento* aux, size_t n, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Ordena la lista de menor a mayor clave, de forma estable, reenlazando
+//       los nodos. No compara elementos: ordena por los bytes de las claves
+//       (radix), llamando una vez a clave por elemento
+// O(n)
+// -----------------------------------------------------------------------------
+void ordenar_lista_por_clave (TLista* lista, FClave clave);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelven para un entero con signo o un real una clave sin signo que
+//       conserva el orden, para usarlas en las FClave
+//       clave_entero(-1) < clave_entero(0), clave_real(-0.5) < clave_real(1e-9)
+//       clave_real distingue -0.0 (va antes) de 0.0
+// -----------------------------------------------------------------------------
+uint64_t clave_entero (int64_t v);
+uint64_t clave_real (double v);
+
 // -----------------------------------------------------------------------------
 // POST: Inserta un elemento en la lista (por la cabeza)
 //       insertar_elemento(crear_lista_vacia, e) = [e]
@@ -84,6 +169,18 @@ void ordenar_lista (TLista* lista, FComparar comparar);
 // -----------------------------------------------------------------------------
 void insertar_elemento (TLista* lista, TElemento e);
 
+// -----------------------------------------------------------------------------
+// POST: Inserta por la cabeza los n elementos de v, como si se llamase a
+//       insertar_elemento con v[0], v[1], ... v[n-1]
+//       insertar_lote(lista, [e1, e2], 2) = [e2, e1 | lista]
+//       Modifica *lista una sola vez
+//       Existe por simetría con insertar_lote_pool: cada nodo se sigue
+//       reservando con su propio malloc (para que se pueda liberar suelto),
+//       así que no ahorra reservas frente a un bucle de insertar_elemento
+//       Para una sola reserva por lote usar insertar_lote_pool
+// -----------------------------------------------------------------------------
+void insertar_lote (TLista* lista, TElemento* v, size_t n);
+
 // -----------------------------------------------------------------------------
 // POST: Busca coincidencias con e en la lista guiándose con la función comparar
 //       Devuelve el número de ocurrencias encontradas
@@ -95,11 +192,110 @@ void insertar_elemento (TLista* lista, TElemento e);
 // -----------------------------------------------------------------------------
 int buscar_elemento (TLista lista, TElemento e, FComparar comparar);
 
+// -----------------------------------------------------------------------------
+// PRE: lista ordenada según comparar (p.ej. tras ordenar_lista)
+// POST: Igual que buscar_elemento pero deja de buscar en el primer elemento
+//       mayor que e
+// -----------------------------------------------------------------------------
+int buscar_elemento_ordenado (TLista lista, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve distinto de cero si algún elemento coincide con e
+//       existe_elemento(lista, e) <=> buscar_elemento(lista, e) > 0
+//       Deja de buscar en la primera coincidencia
+// -----------------------------------------------------------------------------
+int existe_elemento (TLista lista, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el nodo del primer elemento que coincide con e, o NULL si no
+//       hay ninguno. Su dato es nodo->dato y sirve para seguir buscando con
+//       encontrar_siguiente mientras no se borre de la lista
+// -----------------------------------------------------------------------------
+TNodoLista* encontrar_primero (TLista lista, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// PRE: nodo es de la lista (p.ej. devuelto por encontrar_primero) o NULL
+// POST: Devuelve el nodo de la siguiente coincidencia con e después de nodo,
+//       o NULL si no hay más
+//       for (n = encontrar_primero(l, e, c); n; n = encontrar_siguiente(n, e, c))
+//          recorre las buscar_elemento(l, e, c) coincidencias en orden
+// -----------------------------------------------------------------------------
+TNodoLista* encontrar_siguiente (TNodoLista* nodo, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el número de elementos para los que cumple(e, contexto) != 0
+// -----------------------------------------------------------------------------
+int contar_si (TLista lista, FPredicado cumple, void* contexto);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve una lista nueva, en el mismo orden, con los elementos para
+//       los que cumple(e, contexto) != 0. Los elementos no se copian: la lista
+//       nueva apunta a los mismos y debe destruirse sin liberarlos (con un
+//       destruir que no haga nada) mientras la original siga usándolos
+// -----------------------------------------------------------------------------
+TLista filtrar (TLista lista, FPredicado cumple, void* contexto);
+
+// -----------------------------------------------------------------------------
+// Operaciones que reenlazan los nodos existentes
+// No reservan ni liberan nodos. Con pool, las dos listas deben ser del mismo
+// pool (o las dos sin pool)
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// POST: Añade los elementos de *otra al final de *lista y deja *otra vacía
+//       concatenar([e1, e2], [e3]) = [e1, e2, e3]
+// O(longitud de *lista)
+// -----------------------------------------------------------------------------
+void concatenar (TLista* lista, TLista* otra);
+
+// -----------------------------------------------------------------------------
+// POST: Deja en *lista sus pos primeros elementos y devuelve la lista con los
+//       demás (vacía si la lista tiene pos elementos o menos)
+//       dividir_en([e1, e2, e3], 1) = [e2, e3] y *lista = [e1]
+// O(pos)
+// -----------------------------------------------------------------------------
+TLista dividir_en (TLista* lista, int pos);
+
+// -----------------------------------------------------------------------------
+// POST: Deja en *lista los elementos para los que cumple(e, contexto) != 0 y
+//       devuelve la lista con los demás, las dos en el orden original
+// O(n)
+// -----------------------------------------------------------------------------
+TLista partir_por_predicado (TLista* lista, FPredicado cumple, void* contexto);
+
+// -----------------------------------------------------------------------------
+// POST: Invierte el orden de la lista
+//       invertir([e1, e2, e3]) = [e3, e2, e1]
+// O(n)
+// -----------------------------------------------------------------------------
+void invertir (TLista* lista);
+
+// -----------------------------------------------------------------------------
+// PRE: origen y destino son listas distintas
+// POST: Quita de *origen los n elementos que empiezan en la posición desde
+//       (desde 0) y los pone, en el mismo orden, en *destino delante del que
+//       está en la posición pos (al final si pos >= longitud)
+//       Devuelve cuántos se movieron (menos de n si *origen se acaba antes)
+//       mover_rango([e1, e2, e3], 1, 2, [d1, d2], 1) = 2,
+//          *origen = [e1] y *destino = [d1, e2, e3, d2]
+// O(desde + n + pos)
+// -----------------------------------------------------------------------------
+int mover_rango (TLista* origen, int desde, int n, TLista* destino, int pos);
+
 // -----------------------------------------------------------------------------
 // POST: Recorre la lista aplicando la función map a cada elemento
+//       Devuelve NULL (el final de la lista)
 // -----------------------------------------------------------------------------
 TNodoLista* recorrer (TLista lista, FMap map);
 
+// -----------------------------------------------------------------------------
+// POST: recorrer, buscar_elemento y borrar_elemento precargarán en caché los
+//       nodos (y sus datos) que están distancia posiciones por delante
+//       Con distancia 0 no se precarga. Por defecto 4
+//       Compilando con -DLISTAS_SIN_PREBUSQUEDA la precarga no existe
+// -----------------------------------------------------------------------------
+void fijar_prebusqueda (int distancia);
+
 // -----------------------------------------------------------------------------
 // POST: Si todos!=0 borra el primer elemento de la lista que coincida con e
 //       Si todos==0 borra todas los elementos de la lista que coinciden con e
@@ -113,6 +309,23 @@ TNodoLista* recorrer (TLista lista, FMap map);
 // -----------------------------------------------------------------------------
 void borrar_elemento (TLista* lista, TElemento e, int todos, FComparar comparar, FDestruir destruir);
 
+// -----------------------------------------------------------------------------
+// POST: Cuenta en una sola pasada las coincidencias de la lista con cualquiera
+//       de las k claves y devuelve el total
+//       Si cuentas no es nulo cuentas[i] = buscar_elemento(lista, claves[i])
+//       Las claves se ordenan internamente con comparar: O((n + k) log k)
+// -----------------------------------------------------------------------------
+int contar_elementos_lote (TLista lista, TElemento* claves, size_t k, FComparar comparar, int* cuentas);
+
+// -----------------------------------------------------------------------------
+// POST: Borra en una sola pasada todos los elementos de la lista que
+//       coinciden con alguna de las k claves, liberándolos con destruir
+//       Devuelve el número de elementos borrados
+//       Equivale a borrar_elemento(lista, claves[i], 1, ...) para cada clave
+//       en O((n + k) log k)
+// -----------------------------------------------------------------------------
+int borrar_elementos_lote (TLista* lista, TElemento* claves, size_t k, FComparar comparar, FDestruir destruir);
+
 // -----------------------------------------------------------------------------
 // POST: Libera la memoria dinámica utilizada por la lista, libera también la
 //       de los elementos utilizando la función apuntada por destruir
@@ -121,5 +334,258 @@ void borrar_elemento (TLista* lista, TElemento e, int todos, FComparar comparar,
 // -----------------------------------------------------------------------------
 void destruir_lista (TLista* lista, FDestruir destruir);
 
+// -----------------------------------------------------------------------------
+// Operaciones de conjuntos
+// Las listas se tratan como conjuntos según comparar: el resultado no tiene
+// elementos repetidos (se queda la primera aparición). Los elementos que se
+// descartan se liberan con destruir y sus nodos con free: son para listas
+// creadas con malloc, las de un pool se operan con las variantes _pool
+// Con hash no nulo se usa un índice hash: O(n + m) esperado y el resultado
+// conserva el orden. Con hash nulo se ordenan las listas: O(n log n + m log m)
+// y el resultado queda ordenado
+// Devuelven el número de elementos descartados
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// POST: Quita de la lista los elementos que coinciden con uno anterior
+//       eliminar_duplicados([e1, e2, e1]) = [e1, e2]
+// -----------------------------------------------------------------------------
+int eliminar_duplicados (TLista* lista, FComparar comparar, FHash hash, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Deja en *a los elementos de *a y de *b, y *b vacía
+//       union_listas([e1, e2], [e2, e3]) = [e1, e2, e3], con el e2 de a
+// -----------------------------------------------------------------------------
+int union_listas (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Deja en *a sus elementos que están en *b
+//       *b conserva sus elementos (con hash nulo queda ordenada)
+//       interseccion_listas([e1, e2], [e2, e3]) = [e2]
+// -----------------------------------------------------------------------------
+int interseccion_listas (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Deja en *a sus elementos que no están en *b
+//       *b conserva sus elementos (con hash nulo queda ordenada)
+//       diferencia_listas([e1, e2], [e2, e3]) = [e1]
+// -----------------------------------------------------------------------------
+int diferencia_listas (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// Operaciones con contexto
+// POST: Iguales que las que no llevan _ctx, pasando contexto en cada llamada
+//       a comparar, map o destruir
+//       Para que la comparación se haga sin llamada indirecta ver
+//       listas_especializadas.h
+//       Sólo existen para estas operaciones sobre TLista: las de lote, pool,
+//       cabecera, conjuntos y las paralelas siguen usando FComparar, FMap y
+//       FDestruir sin contexto
+// -----------------------------------------------------------------------------
+void ordenar_lista_ctx (TLista* lista, FCompararCtx comparar, void* contexto);
+int buscar_elemento_ctx (TLista lista, TElemento e, FCompararCtx comparar, void* contexto);
+int existe_elemento_ctx (TLista lista, TElemento e, FCompararCtx comparar, void* contexto);
+TNodoLista* encontrar_primero_ctx (TLista lista, TElemento e, FCompararCtx comparar, void* contexto);
+TNodoLista* encontrar_siguiente_ctx (TNodoLista* nodo, TElemento e, FCompararCtx comparar, void* contexto);
+void recorrer_ctx (TLista lista, FMapCtx map, void* contexto);
+void borrar_elemento_ctx (TLista* lista, TElemento e, int todos, FCompararCtx comparar,
+                          FDestruirCtx destruir, void* contexto);
+void destruir_lista_ctx (TLista* lista, FDestruirCtx destruir, void* contexto);
+
+// -----------------------------------------------------------------------------
+// Listas con pool de nodos
+// Los nodos se toman de bloques reservados de una vez y los nodos quitados se
+// reutilizan. Una lista creada con un pool sólo debe modificarse con las
+// operaciones _pool de ese mismo pool (buscar, recorrer y ordenar no reservan
+// nodos y sirven igual). El pool es de una sola lista: destruir_lista_pool
+// libera todos sus bloques de golpe
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve un pool vacío que reservará los nodos en bloques de
+//       nodos_por_bloque (si es menor que 1 se usa un tamaño por defecto)
+// -----------------------------------------------------------------------------
+TPoolNodos* crear_pool_nodos (int nodos_por_bloque);
+
+// -----------------------------------------------------------------------------
+// POST: Libera el pool y todos sus bloques
+// -----------------------------------------------------------------------------
+void destruir_pool_nodos (TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que insertar_elemento tomando el nodo de pool
+// -----------------------------------------------------------------------------
+void insertar_elemento_pool (TLista* lista, TElemento e, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que insertar_lote. Los n nodos se toman del pool con una sola
+//       reserva, consecutivos en memoria y en el orden de la lista
+// -----------------------------------------------------------------------------
+void insertar_lote_pool (TLista* lista, TElemento* v, size_t n, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve la lista [v[0], v[1], ... v[n-1]]
+//       Si pool no es nulo los nodos salen de él como en insertar_lote_pool
+//       (la lista se destruirá con destruir_lista_pool)
+//       Con pool nulo cada nodo se reserva por separado, como en insertar_lote
+//       (sólo por simetría: no ahorra reservas)
+// -----------------------------------------------------------------------------
+TLista crear_lista_desde_array (TElemento* v, size_t n, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que borrar_elemento devolviendo los nodos quitados a pool
+// -----------------------------------------------------------------------------
+void borrar_elemento_pool (TLista* lista, TElemento e, int todos, FComparar comparar, FDestruir destruir, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// PRE: Los nodos de *a (y en union_listas_pool también los de *b) son de pool
+// POST: Iguales que las operaciones de conjuntos devolviendo los nodos
+//       descartados a pool
+// -----------------------------------------------------------------------------
+int eliminar_duplicados_pool (TLista* lista, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool);
+int union_listas_pool (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool);
+int interseccion_listas_pool (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool);
+int diferencia_listas_pool (TLista* a, TLista* b, FComparar comparar, FHash hash, FDestruir destruir, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// POST: Destruye los elementos con destruir y libera todos los bloques del
+//       pool de una vez. La lista queda vacía y el pool puede reutilizarse
+// -----------------------------------------------------------------------------
+void destruir_lista_pool (TLista* lista, FDestruir destruir, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// Compactación
+// Tras muchas inserciones y borrados los nodos quedan dispersos en memoria y
+// recorrer la lista falla en caché. Compactar copia los nodos, en el orden de
+// la lista, a un único bloque nuevo y libera los antiguos
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// PRE: pool es el pool de los nodos de la lista, o NULL si se crearon con
+//      malloc
+// POST: Deja la lista en un bloque contiguo de un pool nuevo, que devuelve
+//       Desde entonces la lista es del pool nuevo (destruir_lista_pool), que
+//       reserva los nodos que se inserten después en bloques del tamaño de
+//       los de pool (del tamaño por defecto si pool es nulo)
+//       Los bloques del pool viejo se liberan, pero el pool sigue siendo del
+//       llamador: queda vacío y hay que destruirlo con destruir_pool_nodos
+// O(n)
+// -----------------------------------------------------------------------------
+TPoolNodos* compactar_lista (TLista* lista, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// PRE: Igual que compactar_lista. Mientras dure la compactación la lista
+//      puede recorrerse pero no modificarse, y *lista no debe moverse
+// POST: Prepara la compactación por pasos: reserva el bloque nuevo y no
+//       mueve ningún nodo. El pool nuevo queda en el campo destino
+// O(n)
+// -----------------------------------------------------------------------------
+TCompactacion iniciar_compactacion (TLista* lista, TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// POST: Mueve al bloque nuevo como mucho los n siguientes nodos y devuelve
+//       los que faltan. La compactación termina cuando devuelve 0
+//       Hasta entonces los nodos movidos quedan en la lista libre del pool
+//       viejo; al terminar se liberan sus bloques como en compactar_lista
+// O(n)
+// -----------------------------------------------------------------------------
+int compactar_pasos (TCompactacion* compactacion, int n);
+
+
+// -----------------------------------------------------------------------------
+// Listas con cabecera
+// Mantienen la cola y la longitud para que añadir por el final y consultar la
+// longitud sean O(1). Sólo deben modificarse con las operaciones de cabecera
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve una cabecera de lista vacía
+//       longitud(crear_cabecera_vacia) = 0
+// -----------------------------------------------------------------------------
+TCabecera crear_cabecera_vacia (void);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que crear_cabecera_vacia pero los nodos saldrán de pool
+//       destruir_lista_cab liberará los bloques de pool
+// -----------------------------------------------------------------------------
+TCabecera crear_cabecera_con_pool (TPoolNodos* pool);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el número de elementos de la lista en O(1)
+//       longitud(insertar_cabeza(cab, e)) = longitud(cab) + 1
+// -----------------------------------------------------------------------------
+int longitud (TCabecera* cab);
 
+// -----------------------------------------------------------------------------
+// POST: Inserta un elemento por la cabeza (como insertar_elemento)
+// -----------------------------------------------------------------------------
+void insertar_cabeza (TCabecera* cab, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Inserta un elemento por el final en O(1)
+//       insertar_final(insertar_final(crear_cabecera_vacia, e1), e2) = [e1, e2]
+// -----------------------------------------------------------------------------
+void insertar_final (TCabecera* cab, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que insertar_lote manteniendo la cola y la longitud
+//       Si la cabecera tiene pool los nodos se reservan de una vez
+// -----------------------------------------------------------------------------
+void insertar_lote_cab (TCabecera* cab, TElemento* v, size_t n);
+
+// -----------------------------------------------------------------------------
+// POST: Quita el primer nodo y devuelve su elemento sin destruirlo
+//       Devuelve NULL si la lista está vacía
+// -----------------------------------------------------------------------------
+TElemento extraer_primero (TCabecera* cab);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que borrar_elemento manteniendo la cola y la longitud
+// -----------------------------------------------------------------------------
+void borrar_elemento_cab (TCabecera* cab, TElemento e, int todos, FComparar comparar, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que borrar_elementos_lote manteniendo la cola y la longitud
+// -----------------------------------------------------------------------------
+int borrar_elementos_lote_cab (TCabecera* cab, TElemento* claves, size_t k, FComparar comparar, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que buscar_elemento. Si la cabecera tiene índice se usa en lugar
+//       de recorrer la lista
+// O(1 + ocurrencias) esperado con índice, O(n) sin él
+// -----------------------------------------------------------------------------
+int buscar_elemento_cab (TCabecera* cab, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que ordenar_lista manteniendo la cola
+// -----------------------------------------------------------------------------
+void ordenar_lista_cab (TCabecera* cab, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que destruir_lista, la cabecera queda vacía
+//       Si tiene índice queda vacío y se libera con destruir_indice_hash
+// -----------------------------------------------------------------------------
+void destruir_lista_cab (TCabecera* cab, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// Índice hash
+// Asocia a cada nodo el enlace que lo apunta, de modo que buscar_elemento_cab,
+// borrar_elemento_cab y borrar_elementos_lote_cab cuestan O(1) esperado por
+// coincidencia. Las operaciones de cabecera lo mantienen al día; a cambio
+// cada nodo ocupa una entrada más en el índice
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// PRE: comparar es la misma que se pasará a las operaciones de cabecera
+// POST: Crea el índice de la lista con los nodos que ya tiene (si ya había uno
+//       lo sustituye)
+// O(n)
+// -----------------------------------------------------------------------------
+void crear_indice_hash (TCabecera* cab, FHash hash, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Libera el índice, la lista no cambia
+// -----------------------------------------------------------------------------
+void destruir_indice_hash (TCabecera* cab);
 
+#endif
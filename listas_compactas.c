@@ -0,0 +1,351 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "listas_compactas.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+// Nodos de la arena al insertar el primer elemento
+#define COMPACTA_CAPACIDAD_INICIAL 16
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TListaCompacta* crear_lista_compacta (int tam_dato)
+{
+	TListaCompacta* lista;
+	
+	lista = (TListaCompacta*)malloc(sizeof(TListaCompacta));
+	lista->siguientes = NULL;
+	lista->datos = NULL;
+	lista->tam_dato = (tam_dato > 0) ? tam_dato : 0;
+	lista->tam = (tam_dato > 0) ? tam_dato : (int)sizeof(TElemento);
+	lista->cabeza = NODO_COMPACTO_NULO;
+	lista->libres = NODO_COMPACTO_NULO;
+	lista->usados = 0;
+	lista->capacidad = 0;
+	lista->longitud = 0;
+	
+	return lista;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+int es_lista_compacta_vacia (TListaCompacta* lista)
+{
+	return lista->cabeza == NODO_COMPACTO_NULO;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el elemento del nodo i como lo reciben las funciones: el
+//       TElemento guardado o un puntero a su dato en la arena
+// O(1)
+// -----------------------------------------------------------------------------
+TElemento elemento_compacto (TListaCompacta* lista, uint32_t i)
+{
+	TElemento e;
+	
+	if (lista->tam_dato > 0)
+		return lista->datos + (size_t)i * lista->tam;
+	
+	memcpy (&e, lista->datos + (size_t)i * lista->tam, sizeof(TElemento));
+	return e;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Cambia la arena a capacidad nodos (los índices se conservan)
+// O(capacidad)
+// -----------------------------------------------------------------------------
+void redimensionar_arena (TListaCompacta* lista, uint32_t capacidad)
+{
+	lista->siguientes = (uint32_t*)realloc(lista->siguientes, (size_t)capacidad * sizeof(uint32_t));
+	lista->datos = (char*)realloc(lista->datos, (size_t)capacidad * lista->tam);
+	lista->capacidad = capacidad;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el índice de un nodo sin usar, de la lista libre o de la
+//       arena (que crece al doble si está llena)
+// O(1) amortizado
+// -----------------------------------------------------------------------------
+uint32_t reservar_nodo_compacto (TListaCompacta* lista)
+{
+	uint32_t i;
+	uint32_t capacidad;
+	
+	if (lista->libres != NODO_COMPACTO_NULO)
+	{
+		i = lista->libres;
+		lista->libres = lista->siguientes[i];
+		return i;
+	}
+	
+	if (lista->usados == lista->capacidad)
+	{
+		// El último índice queda reservado como nulo
+		if (lista->capacidad == 0)
+			capacidad = COMPACTA_CAPACIDAD_INICIAL;
+		else if (lista->capacidad < NODO_COMPACTO_NULO / 2)
+			capacidad = lista->capacidad * 2;
+		else
+			capacidad = NODO_COMPACTO_NULO;
+		redimensionar_arena (lista, capacidad);
+	}
+	
+	return lista->usados++;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1) amortizado
+// -----------------------------------------------------------------------------
+void insertar_elemento_compacta (TListaCompacta* lista, TElemento e)
+{
+	uint32_t i;
+	
+	i = reservar_nodo_compacto (lista);
+	if (lista->tam_dato > 0)
+		memcpy (lista->datos + (size_t)i * lista->tam, e, lista->tam);
+	else
+		memcpy (lista->datos + (size_t)i * lista->tam, &e, sizeof(TElemento));
+	
+	lista->siguientes[i] = lista->cabeza;
+	lista->cabeza = i;
+	lista->longitud++;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int buscar_elemento_compacta (TListaCompacta* lista, TElemento e, FComparar comparar)
+{
+	uint32_t i;
+	int n;
+	
+	n = 0;
+	for (i = lista->cabeza; i != NODO_COMPACTO_NULO; i = lista->siguientes[i])
+	{
+		if (comparar (e, elemento_compacto (lista, i)) == 0)
+			n++;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void recorrer_compacta (TListaCompacta* lista, FMap map)
+{
+	uint32_t i;
+	
+	for (i = lista->cabeza; i != NODO_COMPACTO_NULO; i = lista->siguientes[i])
+		map (elemento_compacto (lista, i));
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void borrar_elemento_compacta (TListaCompacta* lista, TElemento e, int todos, FComparar comparar, FDestruir destruir)
+{
+	uint32_t* enlace;
+	uint32_t i;
+	
+	enlace = &(lista->cabeza);
+	while ((i = *enlace) != NODO_COMPACTO_NULO)
+	{
+		if (comparar (e, elemento_compacto (lista, i)) != 0)
+		{
+			enlace = &(lista->siguientes[i]);
+			continue;
+		}
+		
+		*enlace = lista->siguientes[i];
+		if (destruir != NULL)
+			destruir (elemento_compacto (lista, i));
+		lista->siguientes[i] = lista->libres;
+		lista->libres = i;
+		lista->longitud--;
+		
+		if (!todos)
+			break;
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: aux tiene sitio para n índices
+// POST: Ordena los n índices de v según los elementos de sus nodos (mezcla
+//       ascendente estable)
+// O(n log n)
+// -----------------------------------------------------------------------------
+void ordenar_indices_compactos (TListaCompacta* lista, uint32_t* v, uint32_t* aux, int n, FComparar comparar)
+{
+	uint32_t* origen;
+	uint32_t* destino;
+	uint32_t* tmp;
+	int ancho, inicio, medio, fin, a, b, k;
+	
+	origen = v;
+	destino = aux;
+	for (ancho = 1; ancho < n; ancho *= 2)
+	{
+		for (inicio = 0; inicio < n; inicio += 2 * ancho)
+		{
+			medio = (inicio + ancho < n) ? inicio + ancho : n;
+			fin = (medio + ancho < n) ? medio + ancho : n;
+			a = inicio;
+			b = medio;
+			for (k = inicio; k < fin; k++)
+			{
+				if ((a < medio) && ((b >= fin) ||
+				    (comparar (elemento_compacto (lista, origen[a]), elemento_compacto (lista, origen[b])) <= 0)))
+					destino[k] = origen[a++];
+				else
+					destino[k] = origen[b++];
+			}
+		}
+		tmp = origen;
+		origen = destino;
+		destino = tmp;
+	}
+	
+	if (origen != v)
+		memcpy (v, origen, (size_t)n * sizeof(uint32_t));
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log n)
+// -----------------------------------------------------------------------------
+void ordenar_lista_compacta (TListaCompacta* lista, FComparar comparar)
+{
+	uint32_t* v;
+	uint32_t i;
+	int n, k;
+	
+	n = lista->longitud;
+	if (n < 2)
+		return;
+	
+	v = (uint32_t*)malloc((size_t)n * 2 * sizeof(uint32_t));
+	k = 0;
+	for (i = lista->cabeza; i != NODO_COMPACTO_NULO; i = lista->siguientes[i])
+		v[k++] = i;
+	
+	ordenar_indices_compactos (lista, v, v + n, n, comparar);
+	
+	lista->cabeza = v[0];
+	for (k = 0; k < n - 1; k++)
+		lista->siguientes[v[k]] = v[k+1];
+	lista->siguientes[v[n-1]] = NODO_COMPACTO_NULO;
+	
+	free (v);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void ajustar_lista_compacta (TListaCompacta* lista)
+{
+	uint32_t* siguientes;
+	char* datos;
+	uint32_t i, k, n;
+	
+	n = (uint32_t)lista->longitud;
+	if (n == 0)
+	{
+		free (lista->siguientes);
+		free (lista->datos);
+		lista->siguientes = NULL;
+		lista->datos = NULL;
+		lista->libres = NODO_COMPACTO_NULO;
+		lista->usados = 0;
+		lista->capacidad = 0;
+		return;
+	}
+	
+	siguientes = (uint32_t*)malloc((size_t)n * sizeof(uint32_t));
+	datos = (char*)malloc((size_t)n * lista->tam);
+	k = 0;
+	for (i = lista->cabeza; i != NODO_COMPACTO_NULO; i = lista->siguientes[i])
+	{
+		memcpy (datos + (size_t)k * lista->tam, lista->datos + (size_t)i * lista->tam, lista->tam);
+		siguientes[k] = k + 1;
+		k++;
+	}
+	siguientes[n-1] = NODO_COMPACTO_NULO;
+	
+	free (lista->siguientes);
+	free (lista->datos);
+	lista->siguientes = siguientes;
+	lista->datos = datos;
+	lista->cabeza = 0;
+	lista->libres = NODO_COMPACTO_NULO;
+	lista->usados = n;
+	lista->capacidad = n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+double bytes_por_elemento_compacta (TListaCompacta* lista)
+{
+	double total;
+	
+	total = sizeof(TListaCompacta) + (double)lista->capacidad * (sizeof(uint32_t) + lista->tam);
+	if (lista->longitud == 0)
+		return total;
+	
+	return total / lista->longitud;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_lista_compacta (TListaCompacta* lista, FDestruir destruir)
+{
+	uint32_t i;
+	
+	if (destruir != NULL)
+	{
+		for (i = lista->cabeza; i != NODO_COMPACTO_NULO; i = lista->siguientes[i])
+			destruir (elemento_compacto (lista, i));
+	}
+	
+	free (lista->siguientes);
+	free (lista->datos);
+	free (lista);
+}
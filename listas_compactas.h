@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_COMPACTAS_H
+#define LISTAS_COMPACTAS_H
+
+#include <stdint.h>
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Lista compacta
+//
+// Los nodos viven en una arena (vectores que crecen al doble) y se enlazan
+// con índices de 32 bits en lugar de punteros: el siguiente de cada nodo es
+// un uint32_t en siguientes[] y su dato está en datos[], sin cabecera de
+// malloc por nodo. Los nodos quitados se reutilizan (lista libre por los
+// mismos índices)
+//
+// El dato de cada nodo es un TElemento (tam_dato 0) u ocupa tam_dato bytes
+// dentro de la arena: así los datos pequeños no necesitan su propia reserva.
+// Con datos en la arena, las funciones reciben un puntero al dato copiado,
+// válido hasta la siguiente inserción o ajuste (la arena puede moverse), y
+// alineado si tam_dato es múltiplo de la alineación del tipo
+//
+// Un elemento ocupa 4 + sizeof(TElemento) bytes (12 en 64 bits) en lugar de
+// los 16 de un TNodoLista más la cabecera de malloc
+// -----------------------------------------------------------------------------
+
+// Índice nulo (fin de lista)
+#define NODO_COMPACTO_NULO UINT32_MAX
+
+typedef struct lista_compacta
+{
+	uint32_t* siguientes;   // siguientes[i]: índice del nodo que va tras i
+	char*     datos;        // dato del nodo i en datos + i * tam
+	int       tam_dato;     // 0 si se guardan TElemento
+	int       tam;          // bytes del dato de cada nodo en datos
+	uint32_t  cabeza;
+	uint32_t  libres;       // nodos quitados, enlazados por siguientes
+	uint32_t  usados;       // nodos de la arena entregados alguna vez
+	uint32_t  capacidad;
+	int       longitud;
+} TListaCompacta;
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve una lista compacta vacía. Con tam_dato > 0 los
+//       elementos se copian en la arena (tam_dato bytes), con 0 se guardan
+//       los TElemento
+// -----------------------------------------------------------------------------
+TListaCompacta* crear_lista_compacta (int tam_dato);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve distinto de cero si la lista no contiene elementos
+// -----------------------------------------------------------------------------
+int es_lista_compacta_vacia (TListaCompacta* lista);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que insertar_elemento. Con tam_dato > 0 se copian los tam_dato
+//       bytes a los que apunta e
+// O(1) amortizado
+// -----------------------------------------------------------------------------
+void insertar_elemento_compacta (TListaCompacta* lista, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que buscar_elemento
+// -----------------------------------------------------------------------------
+int buscar_elemento_compacta (TListaCompacta* lista, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que recorrer
+// -----------------------------------------------------------------------------
+void recorrer_compacta (TListaCompacta* lista, FMap map);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que borrar_elemento. destruir puede ser NULL si los elementos
+//       no tienen nada que liberar
+// -----------------------------------------------------------------------------
+void borrar_elemento_compacta (TListaCompacta* lista, TElemento e, int todos, FComparar comparar, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que ordenar_lista (estable, reenlaza los nodos)
+//       Usa un vector auxiliar de 2 índices por elemento
+// O(n log n)
+// -----------------------------------------------------------------------------
+void ordenar_lista_compacta (TListaCompacta* lista, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Recoloca los nodos en la arena en el orden de la lista (los
+//       recorridos pasan a ser secuenciales) y la reduce a la longitud de la
+//       lista, sin nodos libres
+// O(n)
+// -----------------------------------------------------------------------------
+void ajustar_lista_compacta (TListaCompacta* lista);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve los bytes que ocupa la lista (arena incluida la parte sin
+//       usar y la propia estructura) divididos entre su longitud, o los
+//       bytes totales si está vacía. No cuenta la memoria a la que apuntan
+//       los TElemento
+// -----------------------------------------------------------------------------
+double bytes_por_elemento_compacta (TListaCompacta* lista);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que destruir_lista, libera también la lista y su arena
+//       destruir puede ser NULL si los elementos no tienen nada que liberar
+// -----------------------------------------------------------------------------
+void destruir_lista_compacta (TListaCompacta* lista, FDestruir destruir);
+
+#endif
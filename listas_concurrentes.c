@@ -0,0 +1,232 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "listas_concurrentes.h"
+#include <stdlib.h>
+
+// Nodos por bloque cuando no se indica un tamaño al crear la lista
+#define CONCURRENTE_NODOS_POR_BLOQUE 1024
+
+
+// -----------------------------------------------------------------------------
+// POST: Lee el next de un nodo que otro hilo puede estar modificando
+//       (el valor sólo se usa si el CAS posterior confirma la cima)
+// O(1)
+// -----------------------------------------------------------------------------
+TNodoLista* leer_siguiente (TNodoLista* ptrnodo)
+{
+	return __atomic_load_n (&(ptrnodo->next), __ATOMIC_RELAXED);
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: primero..ultimo es una cadena de nodos que sólo conoce este hilo
+// POST: Coloca la cadena delante de la pila
+// O(1) sin contención
+// -----------------------------------------------------------------------------
+void apilar_cadena (_Atomic TCima* pila, TNodoLista* primero, TNodoLista* ultimo)
+{
+	TCima actual, nueva;
+	
+	actual = atomic_load (pila);
+	do
+	{
+		__atomic_store_n (&(ultimo->next), actual.nodo, __ATOMIC_RELAXED);
+		nueva.nodo = primero;
+		nueva.etiqueta = actual.etiqueta + 1;
+	}
+	while (!atomic_compare_exchange_weak (pila, &actual, nueva));
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita el primer nodo de la pila y lo devuelve, NULL si está vacía
+// O(1) sin contención
+// -----------------------------------------------------------------------------
+TNodoLista* desapilar (_Atomic TCima* pila)
+{
+	TCima actual, nueva;
+	
+	actual = atomic_load (pila);
+	do
+	{
+		if (actual.nodo == NULL)
+			return NULL;
+		// Si otro hilo cambió la cima la etiqueta no coincide y se reintenta
+		nueva.nodo = leer_siguiente (actual.nodo);
+		nueva.etiqueta = actual.etiqueta + 1;
+	}
+	while (!atomic_compare_exchange_weak (pila, &actual, nueva));
+	
+	return actual.nodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TListaConcurrente* crear_lista_concurrente (int nodos_por_bloque)
+{
+	TListaConcurrente* lista;
+	TCima vacia;
+	
+	lista = (TListaConcurrente*)malloc(sizeof(TListaConcurrente));
+	
+	vacia.nodo = NULL;
+	vacia.etiqueta = 0;
+	atomic_init (&(lista->cima), vacia);
+	atomic_init (&(lista->libres), vacia);
+	atomic_init (&(lista->bloques), NULL);
+	lista->nodos_por_bloque = (nodos_por_bloque < 1) ? CONCURRENTE_NODOS_POR_BLOQUE : nodos_por_bloque;
+	
+	return lista;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve un nodo libre. Si no quedan reserva un bloque, se queda con
+//       su primer nodo y deja los demás en la pila de libres
+// O(1) amortizado
+// -----------------------------------------------------------------------------
+TNodoLista* obtener_nodo (TListaConcurrente* lista)
+{
+	TNodoLista* ptrnodo;
+	TBloqueConcurrente* bloque;
+	int i, n;
+	
+	ptrnodo = desapilar (&(lista->libres));
+	if (ptrnodo != NULL)
+		return ptrnodo;
+	
+	n = lista->nodos_por_bloque;
+	bloque = (TBloqueConcurrente*)malloc(sizeof(TBloqueConcurrente) + n * sizeof(TNodoLista));
+	
+	bloque->sig = atomic_load (&(lista->bloques));
+	while (!atomic_compare_exchange_weak (&(lista->bloques), &(bloque->sig), bloque))
+		;
+	
+	if (n > 1)
+	{
+		for (i=1; i<n-1; i++)
+			bloque->nodos[i].next = &(bloque->nodos[i+1]);
+		apilar_cadena (&(lista->libres), &(bloque->nodos[1]), &(bloque->nodos[n-1]));
+	}
+	return &(bloque->nodos[0]);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1) sin contención
+// -----------------------------------------------------------------------------
+void insertar_concurrente (TListaConcurrente* lista, TElemento e)
+{
+	TNodoLista* ptrnodo;
+	
+	ptrnodo = obtener_nodo (lista);
+	ptrnodo->dato = e;
+	apilar_cadena (&(lista->cima), ptrnodo, ptrnodo);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1) sin contención
+// -----------------------------------------------------------------------------
+TElemento extraer_cabeza (TListaConcurrente* lista)
+{
+	TNodoLista* ptrnodo;
+	TElemento e;
+	
+	ptrnodo = desapilar (&(lista->cima));
+	if (ptrnodo == NULL)
+		return NULL;
+	
+	e = ptrnodo->dato;
+	apilar_cadena (&(lista->libres), ptrnodo, ptrnodo);
+	return e;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TLista drenar (TListaConcurrente* lista)
+{
+	TCima actual, vacia;
+	
+	actual = atomic_load (&(lista->cima));
+	do
+	{
+		vacia.nodo = NULL;
+		vacia.etiqueta = actual.etiqueta + 1;
+	}
+	while (!atomic_compare_exchange_weak (&(lista->cima), &actual, vacia));
+	
+	return actual.nodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void liberar_drenados (TListaConcurrente* lista, TLista* drenada, FDestruir destruir)
+{
+	TNodoLista* ptrnodo;
+	
+	if (es_lista_vacia (*drenada))
+		return;
+	
+	ptrnodo = *drenada;
+	while (1)
+	{
+		if (destruir != NULL)
+			destruir (ptrnodo->dato);
+		if (ptrnodo->next == NULL)
+			break;
+		ptrnodo = ptrnodo->next;
+	}
+	
+	// Toda la cadena vuelve a los libres con un solo CAS
+	apilar_cadena (&(lista->libres), *drenada, ptrnodo);
+	*drenada = crear_lista_vacia();
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_lista_concurrente (TListaConcurrente* lista, FDestruir destruir)
+{
+	TNodoLista* ptrnodo;
+	TBloqueConcurrente* bloque;
+	TBloqueConcurrente* sig;
+	
+	for (ptrnodo = atomic_load (&(lista->cima)).nodo; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		destruir (ptrnodo->dato);
+	
+	for (bloque = atomic_load (&(lista->bloques)); bloque != NULL; bloque = sig)
+	{
+		sig = bloque->sig;
+		free (bloque);
+	}
+	free (lista);
+}
@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_CONCURRENTES_H
+#define LISTAS_CONCURRENTES_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Lista concurrente (pila de Treiber): varios hilos pueden insertar y extraer
+// por la cabeza a la vez sin cerrojos, con compare-and-swap (C11 atomics)
+//
+// La cabeza va acompañada de una etiqueta que cambia en cada modificación,
+// así un CAS con una cabeza que se quitó y volvió a ponerse (problema ABA)
+// falla. Los nodos salen de bloques propios de la lista y los que se quitan
+// se reutilizan en vez de liberarse: leer el next de un nodo que otro hilo
+// acaba de extraer es siempre seguro. Los bloques se liberan al destruir
+// la lista
+//
+// El CAS de cabeza + etiqueta es de doble palabra (enlazar con -latomic)
+// -----------------------------------------------------------------------------
+
+// Cabeza de pila con etiqueta contra ABA
+typedef struct cima
+{
+	TNodoLista* nodo;
+	uintptr_t   etiqueta;
+} TCima;
+
+// Bloque de nodos de una lista concurrente
+typedef struct bloque_concurrente
+{
+	struct bloque_concurrente* sig;
+	TNodoLista                 nodos[];
+} TBloqueConcurrente;
+
+typedef struct lista_concurrente
+{
+	_Atomic TCima                cima;      // elementos de la lista
+	_Atomic TCima                libres;    // nodos para reutilizar
+	_Atomic(TBloqueConcurrente*) bloques;
+	int                          nodos_por_bloque;
+} TListaConcurrente;
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve una lista concurrente vacía cuyos nodos se reservarán
+//       en bloques de nodos_por_bloque (si es menor que 1, tamaño por defecto)
+// -----------------------------------------------------------------------------
+TListaConcurrente* crear_lista_concurrente (int nodos_por_bloque);
+
+// -----------------------------------------------------------------------------
+// POST: Inserta un elemento por la cabeza. Puede llamarse desde varios hilos
+// -----------------------------------------------------------------------------
+void insertar_concurrente (TListaConcurrente* lista, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Quita el primer elemento y lo devuelve sin destruirlo, o devuelve NULL
+//       si la lista está vacía. Puede llamarse desde varios hilos
+// -----------------------------------------------------------------------------
+TElemento extraer_cabeza (TListaConcurrente* lista);
+
+// -----------------------------------------------------------------------------
+// POST: Deja la lista vacía de forma atómica y devuelve todos sus nodos como
+//       una TLista normal (en orden de cabeza a cola) para que un solo hilo
+//       la procese con buscar_elemento, recorrer, ordenar_lista...
+//       Los nodos siguen siendo de la lista concurrente: no se insertan ni se
+//       borran elementos en ella, se devuelve con liberar_drenados
+// -----------------------------------------------------------------------------
+TLista drenar (TListaConcurrente* lista);
+
+// -----------------------------------------------------------------------------
+// PRE: *drenada se obtuvo con drenar de esta lista
+// POST: Destruye los elementos de *drenada con destruir (si no es nulo) y
+//       devuelve sus nodos a la lista concurrente. *drenada queda vacía
+// -----------------------------------------------------------------------------
+void liberar_drenados (TListaConcurrente* lista, TLista* drenada, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// PRE: Ningún otro hilo utiliza la lista y no quedan listas drenadas sin
+//      liberar
+// POST: Destruye los elementos con destruir y libera la lista y sus bloques
+// -----------------------------------------------------------------------------
+void destruir_lista_concurrente (TListaConcurrente* lista, FDestruir destruir);
+
+#endif
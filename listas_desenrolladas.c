@@ -0,0 +1,260 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "listas_desenrolladas.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Por debajo de este número de elementos se intenta fusionar un nodo
+#define MITAD_NODO (ELEMENTOS_POR_NODO / 2)
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TListaDesenrollada crear_lista_desenrollada_vacia (void)
+{
+	return NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+int es_lista_desenrollada_vacia (TListaDesenrollada lista)
+{
+	return lista == NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea un nodo vacío que apunta a sig
+// O(1)
+// -----------------------------------------------------------------------------
+TNodoDesenrollado* crear_nodo_desenrollado (TNodoDesenrollado* sig)
+{
+	TNodoDesenrollado* ptr;
+	ptr = (TNodoDesenrollado*)malloc(sizeof(TNodoDesenrollado));
+	
+	ptr->n = 0;
+	ptr->next = sig;
+	
+	return ptr;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(ELEMENTOS_POR_NODO)
+// -----------------------------------------------------------------------------
+void insertar_elemento_d (TListaDesenrollada* ptrlista, TElemento e)
+{
+	TNodoDesenrollado* ptrnodo;
+	
+	ptrnodo = *ptrlista;
+	if ((ptrnodo == NULL) || (ptrnodo->n == ELEMENTOS_POR_NODO))
+	{
+		ptrnodo = crear_nodo_desenrollado (*ptrlista);
+		*ptrlista = ptrnodo;
+	}
+	
+	// Hace sitio en la primera posición
+	memmove (&(ptrnodo->datos[1]), &(ptrnodo->datos[0]), ptrnodo->n * sizeof(TElemento));
+	ptrnodo->datos[0] = e;
+	ptrnodo->n++;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int buscar_elemento_d (TListaDesenrollada lista, TElemento e, FComparar comparar)
+{
+	TNodoDesenrollado* ptrnodo;
+	int i, n;
+	
+	n = 0;
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		for (i=0; i<ptrnodo->n; i++)
+		{
+			if (comparar(e, ptrnodo->datos[i]) == 0)
+				n++;
+		}
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void recorrer_d (TListaDesenrollada lista, FMap map)
+{
+	TNodoDesenrollado* ptrnodo;
+	int i;
+	
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		for (i=0; i<ptrnodo->n; i++)
+			map (ptrnodo->datos[i]);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void borrar_elemento_d (TListaDesenrollada* ptrlista, TElemento e, int todos, FComparar comparar, FDestruir destruir)
+{
+	TNodoDesenrollado** ptrptrnodo;
+	TNodoDesenrollado* ptrnodo;
+	TNodoDesenrollado* ant;
+	int i, j;
+	int borrado;    // ya se borró el único elemento pedido
+	int tras;       // nodos revisados después del borrado
+	
+	ant = NULL;
+	borrado = 0;
+	tras = 0;
+	ptrptrnodo = ptrlista;
+	while (*ptrptrnodo != NULL)
+	{
+		// Tras el borrado sólo falta revisar si el nodo siguiente se fusiona
+		if (borrado && (++tras > 1))
+			break;
+		
+		ptrnodo = *ptrptrnodo;
+		if (!borrado)
+		{
+			// Compacta el vector quitando las coincidencias (conserva el orden)
+			j = 0;
+			for (i=0; i<ptrnodo->n; i++)
+			{
+				if (!borrado && (comparar(e, ptrnodo->datos[i]) == 0))
+				{
+					destruir (ptrnodo->datos[i]);
+					borrado = !todos;
+				}
+				else
+					ptrnodo->datos[j++] = ptrnodo->datos[i];
+			}
+			ptrnodo->n = j;
+		}
+		
+		if (ptrnodo->n == 0)
+		{
+			*ptrptrnodo = ptrnodo->next;
+			free (ptrnodo);
+			continue;
+		}
+		
+		// Fusiona con el anterior si alguno está por debajo de la mitad y caben
+		if ((ant != NULL) && (ant->n + ptrnodo->n <= ELEMENTOS_POR_NODO) &&
+		    ((ant->n < MITAD_NODO) || (ptrnodo->n < MITAD_NODO)))
+		{
+			memcpy (&(ant->datos[ant->n]), ptrnodo->datos, ptrnodo->n * sizeof(TElemento));
+			ant->n += ptrnodo->n;
+			*ptrptrnodo = ptrnodo->next;
+			free (ptrnodo);
+			continue;
+		}
+		
+		ant = ptrnodo;
+		ptrptrnodo = &(ptrnodo->next);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log n)
+// -----------------------------------------------------------------------------
+void ordenar_lista_d (TListaDesenrollada* ptrlista, FComparar comparar)
+{
+	TNodoDesenrollado* ptrnodo;
+	TNodoDesenrollado* sobrante;
+	TElemento* v;
+	int n, i, k;
+	
+	n = 0;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		n += ptrnodo->n;
+	
+	if (n < 2)
+		return;
+	
+	// Copia los elementos a un vector (la segunda mitad es auxiliar)
+	v = (TElemento*)malloc(2 * n * sizeof(TElemento));
+	k = 0;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		memcpy (&(v[k]), ptrnodo->datos, ptrnodo->n * sizeof(TElemento));
+		k += ptrnodo->n;
+	}
+	
+	ordenar_vector (v, v + n, n, comparar);
+	
+	// Vuelve a llenar los nodos por orden, dejándolos completos
+	k = 0;
+	ptrnodo = *ptrlista;
+	while (1)
+	{
+		i = ((n - k) < ELEMENTOS_POR_NODO) ? (n - k) : ELEMENTOS_POR_NODO;
+		memcpy (ptrnodo->datos, &(v[k]), i * sizeof(TElemento));
+		ptrnodo->n = i;
+		k += i;
+		if (k == n)
+			break;
+		ptrnodo = ptrnodo->next;
+	}
+	
+	// Libera los nodos que ya no hacen falta
+	sobrante = ptrnodo->next;
+	ptrnodo->next = NULL;
+	while (sobrante != NULL)
+	{
+		ptrnodo = sobrante;
+		sobrante = sobrante->next;
+		free (ptrnodo);
+	}
+	
+	free (v);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_lista_d (TListaDesenrollada* ptrlista, FDestruir destruir)
+{
+	TNodoDesenrollado* ptrnodo;
+	int i;
+	
+	while (!es_lista_desenrollada_vacia (*ptrlista))
+	{
+		ptrnodo = *ptrlista;
+		for (i=0; i<ptrnodo->n; i++)
+			destruir (ptrnodo->datos[i]);
+		*ptrlista = ptrnodo->next;
+		free (ptrnodo);
+	}
+}
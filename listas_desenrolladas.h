@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_DESENROLLADAS_H
+#define LISTAS_DESENROLLADAS_H
+
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Lista desenrollada: cada nodo ocupa una línea de caché con un vector de
+// elementos, el número de elementos ocupados y el siguiente. Recorrerla sigue
+// un puntero cada ELEMENTOS_POR_NODO elementos en lugar de uno por elemento
+// -----------------------------------------------------------------------------
+#define TAM_LINEA_CACHE 64
+#define ELEMENTOS_POR_NODO ((int)((TAM_LINEA_CACHE - sizeof(void*) - sizeof(int)) / sizeof(TElemento)))
+
+// Definición de la lista desenrollada
+typedef struct nodo_desenrollado
+{
+	struct nodo_desenrollado* next;
+	int                       n;
+	TElemento                 datos[ELEMENTOS_POR_NODO];
+} TNodoDesenrollado;
+
+_Static_assert (sizeof(TNodoDesenrollado) <= TAM_LINEA_CACHE, "el nodo desenrollado no cabe en una línea de caché");
+
+typedef TNodoDesenrollado* TListaDesenrollada;
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve una lista desenrollada vacía
+// -----------------------------------------------------------------------------
+TListaDesenrollada crear_lista_desenrollada_vacia (void);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve distinto de cero si la lista no contiene elementos
+// -----------------------------------------------------------------------------
+int es_lista_desenrollada_vacia (TListaDesenrollada lista);
+
+// -----------------------------------------------------------------------------
+// POST: Inserta un elemento en la lista (por la cabeza), igual que
+//       insertar_elemento. Sólo se crea un nodo nuevo cuando el primero está
+//       lleno
+// -----------------------------------------------------------------------------
+void insertar_elemento_d (TListaDesenrollada* lista, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que buscar_elemento
+// -----------------------------------------------------------------------------
+int buscar_elemento_d (TListaDesenrollada lista, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que recorrer
+// -----------------------------------------------------------------------------
+void recorrer_d (TListaDesenrollada lista, FMap map);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que borrar_elemento
+//       Los nodos que se quedan vacíos se liberan y dos nodos consecutivos se
+//       fusionan cuando uno queda por debajo de la mitad y caben en uno
+// -----------------------------------------------------------------------------
+void borrar_elemento_d (TListaDesenrollada* lista, TElemento e, int todos, FComparar comparar, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que ordenar_lista (estable). Los nodos quedan llenos y se
+//       liberan los que sobran
+// -----------------------------------------------------------------------------
+void ordenar_lista_d (TListaDesenrollada* lista, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que destruir_lista
+// -----------------------------------------------------------------------------
+void destruir_lista_d (TListaDesenrollada* lista, FDestruir destruir);
+
+#endif
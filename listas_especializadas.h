@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_ESPECIALIZADAS_H
+#define LISTAS_ESPECIALIZADAS_H
+
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Recorrido, búsqueda y ordenación especializados para una comparación
+//
+// listas_especializadas_plantilla.h genera versiones static inline de estas
+// operaciones en las que la comparación (y la función de recorrer) es una
+// macro en lugar de un puntero a función, así el compilador puede meterla en
+// el bucle y no hay una llamada indirecta por nodo. Se incluye una vez por
+// comparación, con estas macros definidas:
+//   LE_SUFIJO                     sufijo de los nombres generados
+//   LE_COMPARAR(e1, e2, contexto) expresión con el resultado de un FComparar
+//   LE_MAP(e, contexto)           (opcional) sentencia para recorrer
+//   LE_NODO()                     (opcional) sentencia por nodo recorrido
+//   LE_PRECARGA_INICIO(ptrnodo)   (opcional) declaración al empezar un
+//                                 recorrido o búsqueda desde ptrnodo
+//   LE_PRECARGA_PASO()            (opcional) sentencia por nodo de un
+//                                 recorrido o búsqueda
+//
+//   #define LE_SUFIJO _enteros
+//   #define LE_COMPARAR(e1, e2, contexto) (*(int*)(e1) - *(int*)(e2))
+//   #include "listas_especializadas_plantilla.h"
+//
+// genera (con contexto el puntero que se pasa a cada llamada):
+//   int         buscar_elemento_enteros (TLista lista, TElemento e, void* contexto)
+//   TNodoLista* encontrar_primero_enteros (TLista lista, TElemento e, void* contexto)
+//   int         existe_elemento_enteros (TLista lista, TElemento e, void* contexto)
+//   void        ordenar_lista_enteros (TLista* lista, void* contexto)
+//   void        recorrer_enteros (TLista lista, void* contexto)   (con LE_MAP)
+// que se comportan como las de listas.h del mismo nombre
+//
+// listas.c genera con esta misma plantilla las operaciones de listas.h (y sus
+// variantes _ctx), usando las tres últimas macros para la precarga de
+// fijar_prebusqueda y para las estadísticas. Sin ellas, las funciones
+// generadas no precargan nodos ni anotan estadísticas
+// -----------------------------------------------------------------------------
+
+// Tramos ordenados pendientes de mezclar al ordenar. Las longitudes crecen al
+// menos como Fibonacci de arriba abajo, así 96 tramos bastan para cualquier
+// lista que quepa en memoria
+#define LE_MAX_TRAMOS 96
+
+typedef struct tramos_pendientes
+{
+	TNodoLista* cabezas[LE_MAX_TRAMOS];
+	TNodoLista* colas[LE_MAX_TRAMOS];
+	size_t      longitudes[LE_MAX_TRAMOS];
+	int         n;
+} TTramosPendientes;
+
+// Construcción de nombres dentro de la plantilla
+#define LE_CONCAT_(a, b) a##b
+#define LE_CONCAT(a, b) LE_CONCAT_(a, b)
+#define LE(nombre) LE_CONCAT(nombre, LE_SUFIJO)
+
+#endif
@@ -0,0 +1,321 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// -----------------------------------------------------------------------------
+// Plantilla de operaciones especializadas (se incluye una vez por comparación,
+// sin guarda de inclusión; ver listas_especializadas.h)
+// PRE: LE_SUFIJO y LE_COMPARAR definidos, LE_MAP, LE_NODO, LE_PRECARGA_INICIO
+//      y LE_PRECARGA_PASO opcionales
+// -----------------------------------------------------------------------------
+
+#include "listas_especializadas.h"
+
+#ifndef LE_NODO
+#define LE_NODO() ((void)0)
+#endif
+#ifndef LE_PRECARGA_INICIO
+#define LE_PRECARGA_INICIO(ptrnodo) ((void)0)
+#endif
+#ifndef LE_PRECARGA_PASO
+#define LE_PRECARGA_PASO() ((void)0)
+#endif
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+static inline int LE(buscar_elemento) (TLista lista, TElemento e, void* contexto)
+{
+	TNodoLista* ptrnodo;
+	int n;
+	LE_PRECARGA_INICIO (lista);
+	
+	n = 0;
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		LE_PRECARGA_PASO ();
+		LE_NODO ();
+		if (LE_COMPARAR (e, ptrnodo->dato, contexto) == 0)
+			n++;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(posición de la primera coincidencia)
+// -----------------------------------------------------------------------------
+static inline TNodoLista* LE(encontrar_primero) (TLista lista, TElemento e, void* contexto)
+{
+	TNodoLista* ptrnodo;
+	LE_PRECARGA_INICIO (lista);
+	
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		LE_PRECARGA_PASO ();
+		LE_NODO ();
+		if (LE_COMPARAR (e, ptrnodo->dato, contexto) == 0)
+			break;
+	}
+	return ptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(posición de la primera coincidencia)
+// -----------------------------------------------------------------------------
+static inline int LE(existe_elemento) (TLista lista, TElemento e, void* contexto)
+{
+	return LE(encontrar_primero) (lista, e, contexto) != NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Separa el tramo ordenado con el que empieza *ptrresto y lo devuelve
+//       terminado en NULL. Un tramo estrictamente descendente se invierte
+//       (al no haber iguales sigue siendo estable)
+//       *ptrresto queda apuntando al resto de la lista, *ptrcola al último
+//       nodo del tramo y *ptrlongitud tiene su número de nodos
+// -----------------------------------------------------------------------------
+static inline TNodoLista* LE(extraer_tramo) (TNodoLista** ptrresto, void* contexto, TNodoLista** ptrcola,
+                                             size_t* ptrlongitud)
+{
+	TNodoLista* cabeza;
+	TNodoLista* ptrnodo;
+	TNodoLista* sig;
+	size_t n;
+	
+	ptrnodo = *ptrresto;
+	*ptrcola = ptrnodo;
+	n = 1;
+	
+	if ((ptrnodo->next != NULL) && (LE_COMPARAR (ptrnodo->dato, ptrnodo->next->dato, contexto) > 0))
+	{
+		// Tramo descendente: se invierte mientras se recorre
+		cabeza = NULL;
+		n = 0;
+		do
+		{
+			LE_NODO ();
+			sig = ptrnodo->next;
+			ptrnodo->next = cabeza;
+			cabeza = ptrnodo;
+			ptrnodo = sig;
+			n++;
+		}
+		while ((ptrnodo != NULL) && (LE_COMPARAR (cabeza->dato, ptrnodo->dato, contexto) > 0));
+		
+		*ptrresto = ptrnodo;
+		*ptrlongitud = n;
+		return cabeza;
+	}
+	
+	cabeza = ptrnodo;
+	LE_NODO ();
+	while ((ptrnodo->next != NULL) && (LE_COMPARAR (ptrnodo->dato, ptrnodo->next->dato, contexto) <= 0))
+	{
+		ptrnodo = ptrnodo->next;
+		LE_NODO ();
+		n++;
+	}
+	
+	*ptrresto = ptrnodo->next;
+	ptrnodo->next = NULL;
+	*ptrcola = ptrnodo;
+	*ptrlongitud = n;
+	return cabeza;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: a y b son listas ordenadas no vacías terminadas en NULL, colaa y colab
+//      sus últimos nodos
+// POST: Mezcla a y b reenlazando los nodos y devuelve la lista resultante
+//       Ante elementos iguales se toma primero el de a (mezcla estable)
+//       *ptrcola apunta al último nodo del resultado
+// O(n)
+// -----------------------------------------------------------------------------
+static inline TNodoLista* LE(mezclar) (TNodoLista* a, TNodoLista* colaa, TNodoLista* b, TNodoLista* colab,
+                                       void* contexto, TNodoLista** ptrcola)
+{
+	TNodoLista* res;
+	TNodoLista** ptrptrnodo;
+	
+	// Si los tramos ya están en orden basta con enlazarlos
+	if (LE_COMPARAR (colaa->dato, b->dato, contexto) <= 0)
+	{
+		colaa->next = b;
+		*ptrcola = colab;
+		return a;
+	}
+	
+	ptrptrnodo = &res;
+	while ((a != NULL) && (b != NULL))
+	{
+		if (LE_COMPARAR (a->dato, b->dato, contexto) <= 0)
+		{
+			*ptrptrnodo = a;
+			ptrptrnodo = &(a->next);
+			a = a->next;
+		}
+		else
+		{
+			*ptrptrnodo = b;
+			ptrptrnodo = &(b->next);
+			b = b->next;
+		}
+	}
+	
+	if (a != NULL)
+	{
+		*ptrptrnodo = a;
+		*ptrcola = colaa;
+	}
+	else
+	{
+		*ptrptrnodo = b;
+		*ptrcola = colab;
+	}
+	return res;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: i + 1 < *ptrn
+// POST: Mezcla en la pila de tramos pendientes el tramo i con el i + 1 (el
+//       siguiente en la lista) y quita el hueco que queda
+// O(longitud de los dos tramos)
+// -----------------------------------------------------------------------------
+static inline void LE(mezclar_pendientes) (TTramosPendientes* pila, int i, void* contexto)
+{
+	int j;
+	
+	pila->cabezas[i] = LE(mezclar) (pila->cabezas[i], pila->colas[i], pila->cabezas[i+1], pila->colas[i+1],
+	                                contexto, &(pila->colas[i]));
+	pila->longitudes[i] += pila->longitudes[i+1];
+	for (j = i + 1; j + 1 < pila->n; j++)
+	{
+		pila->cabezas[j] = pila->cabezas[j+1];
+		pila->colas[j] = pila->colas[j+1];
+		pila->longitudes[j] = pila->longitudes[j+1];
+	}
+	pila->n--;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Ordena los nodos a partir de cabeza por mezcla natural ascendente
+//       (iterativa y estable) y devuelve la nueva cabeza
+//       Si ptrcola no es nulo *ptrcola apunta al último nodo
+//       Los tramos ordenados se separan en una sola pasada y se apilan; se
+//       mezclan los de arriba en cuanto sus longitudes dejan de decrecer como
+//       en timsort (cada uno más largo que los dos siguientes juntos), así
+//       las mezclas son equilibradas y se hacen con los nodos aún en caché
+// O(n log r) siendo r el número de tramos: O(n) si la lista ya está ordenada
+// o en orden inverso
+// -----------------------------------------------------------------------------
+static inline TNodoLista* LE(ordenar_nodos) (TNodoLista* cabeza, void* contexto, TNodoLista** ptrcola)
+{
+	TTramosPendientes pila;
+	TNodoLista* resto;
+	int i;
+	
+	if (cabeza == NULL)
+	{
+		if (ptrcola != NULL)
+			*ptrcola = NULL;
+		return NULL;
+	}
+	
+	pila.n = 0;
+	resto = cabeza;
+	while (resto != NULL)
+	{
+		i = pila.n++;
+		pila.cabezas[i] = LE(extraer_tramo) (&resto, contexto, &(pila.colas[i]), &(pila.longitudes[i]));
+		
+		// Se restablece longitudes[i-2] > longitudes[i-1] + longitudes[i] y
+		// longitudes[i-1] > longitudes[i] para toda la pila (con la
+		// comprobación del cuarto tramo que corrige la de timsort original)
+		while (pila.n > 1)
+		{
+			i = pila.n - 2;
+			if (((i > 0) && (pila.longitudes[i-1] <= pila.longitudes[i] + pila.longitudes[i+1])) ||
+			    ((i > 1) && (pila.longitudes[i-2] <= pila.longitudes[i-1] + pila.longitudes[i])))
+			{
+				if (pila.longitudes[i-1] < pila.longitudes[i+1])
+					i--;
+			}
+			else if (pila.longitudes[i] > pila.longitudes[i+1])
+				break;
+			LE(mezclar_pendientes) (&pila, i, contexto);
+		}
+	}
+	
+	// Al final se mezcla lo que queda, de arriba abajo
+	while (pila.n > 1)
+	{
+		i = pila.n - 2;
+		if ((i > 0) && (pila.longitudes[i-1] < pila.longitudes[i+1]))
+			i--;
+		LE(mezclar_pendientes) (&pila, i, contexto);
+	}
+	
+	if (ptrcola != NULL)
+		*ptrcola = pila.colas[0];
+	return pila.cabezas[0];
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log r) siendo r el número de tramos ya ordenados
+// -----------------------------------------------------------------------------
+static inline void LE(ordenar_lista) (TLista* ptrlista, void* contexto)
+{
+	*ptrlista = LE(ordenar_nodos) (*ptrlista, contexto, NULL);
+}
+
+
+#ifdef LE_MAP
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+static inline void LE(recorrer) (TLista lista, void* contexto)
+{
+	TNodoLista* ptrnodo;
+	LE_PRECARGA_INICIO (lista);
+	
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		LE_PRECARGA_PASO ();
+		LE_NODO ();
+		LE_MAP (ptrnodo->dato, contexto);
+	}
+}
+#endif
+
+#undef LE_SUFIJO
+#undef LE_COMPARAR
+#undef LE_MAP
+#undef LE_NODO
+#undef LE_PRECARGA_INICIO
+#undef LE_PRECARGA_PASO
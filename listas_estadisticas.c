@@ -0,0 +1,311 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "listas_estadisticas.h"
+
+const char* nombres_operacion_est[EST_NUM_OPERACIONES] = { "insertar", "buscar", "borrar", "ordenar", "recorrer",
+                                                            "destruir" };
+
+#ifdef LISTAS_ESTADISTICAS
+
+// Bloque de estadísticas de un hilo. Sólo lo escribe su hilo, pero
+// tomar_estadisticas lo lee desde otros: los accesos son atómicos relajados
+typedef struct bloque_est
+{
+	TEstadisticas      est;
+	struct bloque_est* sig;
+} TBloqueEst;
+
+// Bloques de todos los hilos que han usado las listas (no se liberan para
+// no perder lo contado por hilos que ya han terminado)
+TBloqueEst* bloques_est = NULL;
+pthread_mutex_t cerrojo_est = PTHREAD_MUTEX_INITIALIZER;
+
+_Thread_local TBloqueEst* bloque_hilo = NULL;
+_Thread_local TPendientesEst est_pendientes;
+_Thread_local FComparar comparar_real;
+_Thread_local FDestruir destruir_real;
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el bloque del hilo, creándolo y registrándolo la primera vez
+// -----------------------------------------------------------------------------
+TBloqueEst* obtener_bloque_hilo (void)
+{
+	if (bloque_hilo != NULL)
+		return bloque_hilo;
+	
+	bloque_hilo = (TBloqueEst*)calloc(1, sizeof(TBloqueEst));
+	pthread_mutex_lock (&cerrojo_est);
+	bloque_hilo->sig = bloques_est;
+	bloques_est = bloque_hilo;
+	pthread_mutex_unlock (&cerrojo_est);
+	
+	return bloque_hilo;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Suma v a un contador del bloque propio (un solo escritor, no hace
+//       falta lectura-modificación-escritura atómica)
+// -----------------------------------------------------------------------------
+void sumar_contador (long long* contador, long long v)
+{
+	__atomic_store_n (contador, __atomic_load_n (contador, __ATOMIC_RELAXED) + v, __ATOMIC_RELAXED);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la cubeta del histograma para v
+// -----------------------------------------------------------------------------
+int cubeta_est (long long v)
+{
+	int i;
+	
+	if (v <= 0)
+		return 0;
+	i = 64 - __builtin_clzll ((unsigned long long)v);
+	return (i < EST_CUBETAS) ? i : EST_CUBETAS - 1;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Guarda en marco el instante actual en ns, los contadores y las
+//       funciones sustituidas de la operación en curso, y pone a cero los
+//       contadores para la que empieza
+// -----------------------------------------------------------------------------
+void est_iniciar (TMarcoEst* marco)
+{
+	struct timespec ts;
+	
+	marco->pendientes = est_pendientes;
+	marco->comparar = comparar_real;
+	marco->destruir = destruir_real;
+	
+	est_pendientes.nodos = 0;
+	est_pendientes.comparaciones = 0;
+	est_pendientes.destrucciones = 0;
+	
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	marco->inicio = (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Acumula en el bloque del hilo la operación que empezó con marco y
+//       restaura el estado de la operación que la contiene
+// -----------------------------------------------------------------------------
+void est_anotar (TOperacionEst op, TMarcoEst* marco)
+{
+	TEstadisticasOperacion* e;
+	struct timespec ts;
+	long long ns;
+	
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	ns = (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec - marco->inicio;
+	
+	e = &(obtener_bloque_hilo()->est.operaciones[op]);
+	sumar_contador (&(e->llamadas), 1);
+	sumar_contador (&(e->nodos), est_pendientes.nodos);
+	sumar_contador (&(e->comparaciones), est_pendientes.comparaciones);
+	sumar_contador (&(e->destrucciones), est_pendientes.destrucciones);
+	sumar_contador (&(e->duracion[cubeta_est (ns)]), 1);
+	sumar_contador (&(e->recorridos[cubeta_est (est_pendientes.nodos)]), 1);
+	
+	est_pendientes = marco->pendientes;
+	comparar_real = marco->comparar;
+	destruir_real = marco->destruir;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Anota reservas y liberaciones de memoria
+// -----------------------------------------------------------------------------
+void est_memoria (int reservas, int liberaciones)
+{
+	TBloqueEst* bloque;
+	
+	bloque = obtener_bloque_hilo();
+	sumar_contador (&(bloque->est.reservas), reservas);
+	sumar_contador (&(bloque->est.liberaciones), liberaciones);
+}
+
+
+// -----------------------------------------------------------------------------
+// Funciones que cuentan las llamadas a las del usuario
+// -----------------------------------------------------------------------------
+int comparar_contando (TElemento e1, TElemento e2)
+{
+	est_pendientes.comparaciones++;
+	return comparar_real (e1, e2);
+}
+
+void destruir_contando (TElemento e)
+{
+	est_pendientes.destrucciones++;
+	destruir_real (e);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve una función que cuenta las llamadas y llama a comparar
+//       (si comparar ya cuenta se devuelve tal cual)
+// -----------------------------------------------------------------------------
+FComparar est_envolver_comparar (FComparar comparar)
+{
+	if (comparar == comparar_contando)
+		return comparar;
+	comparar_real = comparar;
+	return comparar_contando;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Igual que est_envolver_comparar para destruir
+// -----------------------------------------------------------------------------
+FDestruir est_envolver_destruir (FDestruir destruir)
+{
+	if (destruir == destruir_contando)
+		return destruir;
+	destruir_real = destruir;
+	return destruir_contando;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Aplica a todos los contadores de bloque la suma (total!=NULL) o la
+//       puesta a cero (total==NULL)
+// -----------------------------------------------------------------------------
+void recorrer_contadores (TBloqueEst* bloque, TEstadisticas* total)
+{
+	long long* origen;
+	long long* destino;
+	int i, n;
+	
+	// TEstadisticas sólo contiene long long
+	origen = (long long*)&(bloque->est);
+	destino = (long long*)total;
+	n = sizeof(TEstadisticas) / sizeof(long long);
+	
+	for (i=0; i<n; i++)
+	{
+		if (total != NULL)
+			destino[i] += __atomic_load_n (&origen[i], __ATOMIC_RELAXED);
+		else
+			__atomic_store_n (&origen[i], 0, __ATOMIC_RELAXED);
+	}
+}
+
+#endif
+
+
+// -----------------------------------------------------------------------------
+// O(hilos)
+// -----------------------------------------------------------------------------
+void tomar_estadisticas (TEstadisticas* total)
+{
+#ifdef LISTAS_ESTADISTICAS
+	TBloqueEst* bloque;
+#endif
+	
+	memset (total, 0, sizeof(TEstadisticas));
+	
+#ifdef LISTAS_ESTADISTICAS
+	pthread_mutex_lock (&cerrojo_est);
+	for (bloque = bloques_est; bloque != NULL; bloque = bloque->sig)
+		recorrer_contadores (bloque, total);
+	pthread_mutex_unlock (&cerrojo_est);
+#endif
+}
+
+
+// -----------------------------------------------------------------------------
+// O(hilos)
+// -----------------------------------------------------------------------------
+void reiniciar_estadisticas (void)
+{
+#ifdef LISTAS_ESTADISTICAS
+	TBloqueEst* bloque;
+	
+	pthread_mutex_lock (&cerrojo_est);
+	for (bloque = bloques_est; bloque != NULL; bloque = bloque->sig)
+		recorrer_contadores (bloque, NULL);
+	pthread_mutex_unlock (&cerrojo_est);
+#endif
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Escribe las cubetas no vacías de un histograma
+// -----------------------------------------------------------------------------
+void volcar_histograma (FILE* f, const char* nombre, long long* cubetas)
+{
+	int i;
+	
+	fprintf (f, "  %-10s", nombre);
+	for (i=0; i<EST_CUBETAS; i++)
+	{
+		if (cubetas[i] == 0)
+			continue;
+		if (i == 0)
+			fprintf (f, " [0]:%lld", cubetas[i]);
+		else
+			fprintf (f, " [2^%d]:%lld", i - 1, cubetas[i]);
+	}
+	fprintf (f, "\n");
+}
+
+
+// -----------------------------------------------------------------------------
+// O(hilos)
+// -----------------------------------------------------------------------------
+void volcar_estadisticas (FILE* f)
+{
+	TEstadisticas total;
+	TEstadisticasOperacion* e;
+	int op;
+	
+#ifndef LISTAS_ESTADISTICAS
+	fprintf (f, "Estadísticas no disponibles (compilar con -DLISTAS_ESTADISTICAS)\n");
+	return;
+#endif
+	
+	tomar_estadisticas (&total);
+	fprintf (f, "reservas %lld, liberaciones %lld\n", total.reservas, total.liberaciones);
+	for (op=0; op<EST_NUM_OPERACIONES; op++)
+	{
+		e = &(total.operaciones[op]);
+		if (e->llamadas == 0)
+			continue;
+		
+		fprintf (f, "%s: llamadas %lld, nodos %lld, comparaciones %lld, destrucciones %lld\n",
+		         nombres_operacion_est[op], e->llamadas, e->nodos, e->comparaciones, e->destrucciones);
+		volcar_histograma (f, "ns", e->duracion);
+		volcar_histograma (f, "nodos", e->recorridos);
+	}
+}
@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_ESTADISTICAS_H
+#define LISTAS_ESTADISTICAS_H
+
+#include <stdio.h>
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Estadísticas de las operaciones de listas
+//
+// Sólo se recogen si las listas se compilan con -DLISTAS_ESTADISTICAS; si no,
+// las macros de anotación no generan código y tomar_estadisticas devuelve
+// todo a cero. Cada hilo acumula en su propio bloque sin sincronizarse y
+// tomar_estadisticas suma los bloques de todos los hilos
+//
+// Por operación se cuentan las llamadas, los nodos recorridos, las llamadas a
+// FComparar y a FDestruir, y dos histogramas en potencias de 2: duración en
+// ns y nodos recorridos por llamada. La cubeta i cuenta los valores v con
+// 2^(i-1) <= v < 2^i (la 0 cuenta los ceros)
+// -----------------------------------------------------------------------------
+
+// Cubetas de los histogramas
+#define EST_CUBETAS 64
+
+// Operaciones con estadísticas
+enum OPERACIONES_EST_ENUM { EST_INSERTAR, EST_BUSCAR, EST_BORRAR, EST_ORDENAR, EST_RECORRER, EST_DESTRUIR,
+                            EST_NUM_OPERACIONES };
+typedef enum OPERACIONES_EST_ENUM TOperacionEst;
+
+typedef struct estadisticas_operacion
+{
+	long long llamadas;
+	long long nodos;                    // nodos recorridos
+	long long comparaciones;            // llamadas a FComparar
+	long long destrucciones;            // llamadas a FDestruir
+	long long duracion[EST_CUBETAS];    // ns por llamada
+	long long recorridos[EST_CUBETAS];  // nodos recorridos por llamada
+} TEstadisticasOperacion;
+
+typedef struct estadisticas
+{
+	TEstadisticasOperacion operaciones[EST_NUM_OPERACIONES];
+	long long              reservas;        // malloc de nodos y bloques
+	long long              liberaciones;    // free de nodos y bloques
+} TEstadisticas;
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Copia en *total la suma de las estadísticas de todos los hilos
+//       Los contadores de un hilo que está en mitad de una operación pueden
+//       no incluirla todavía
+// -----------------------------------------------------------------------------
+void tomar_estadisticas (TEstadisticas* total);
+
+// -----------------------------------------------------------------------------
+// POST: Pone a cero las estadísticas de todos los hilos
+// -----------------------------------------------------------------------------
+void reiniciar_estadisticas (void);
+
+// -----------------------------------------------------------------------------
+// POST: Escribe en f las estadísticas de las operaciones que se han usado
+// -----------------------------------------------------------------------------
+void volcar_estadisticas (FILE* f);
+
+
+// -----------------------------------------------------------------------------
+// Anotación (uso interno de las listas)
+// EST_INICIO declara el comienzo de una operación y EST_FIN(op) la anota con
+// lo contado entre medias. EST_CONTAR_COMPARAR y EST_CONTAR_DESTRUIR
+// sustituyen la función recibida por una que cuenta sus llamadas
+// EST_INICIO guarda los contadores y las funciones sustituidas de la
+// operación que esté en curso en el hilo y EST_FIN los restaura, así una
+// FComparar o FDestruir puede llamar a otras operaciones (p.ej. destruir
+// listas de listas). Toda salida de una operación debe pasar por EST_FIN
+// -----------------------------------------------------------------------------
+#ifdef LISTAS_ESTADISTICAS
+
+// Contadores de la operación en curso del hilo
+typedef struct pendientes_est
+{
+	long long nodos;
+	long long comparaciones;
+	long long destrucciones;
+} TPendientesEst;
+
+// Estado de la operación que contiene a la que empieza
+typedef struct marco_est
+{
+	long long      inicio;
+	TPendientesEst pendientes;
+	FComparar      comparar;
+	FDestruir      destruir;
+} TMarcoEst;
+
+extern _Thread_local TPendientesEst est_pendientes;
+
+void est_iniciar (TMarcoEst* marco);
+void est_anotar (TOperacionEst op, TMarcoEst* marco);
+void est_memoria (int reservas, int liberaciones);
+FComparar est_envolver_comparar (FComparar comparar);
+FDestruir est_envolver_destruir (FDestruir destruir);
+
+#define EST_INICIO                      TMarcoEst est_marco; est_iniciar (&est_marco)
+#define EST_FIN(op)                     est_anotar ((op), &est_marco)
+#define EST_NODOS(n)                    (est_pendientes.nodos += (n))
+#define EST_CONTAR_COMPARAR(comparar)   ((comparar) = est_envolver_comparar (comparar))
+#define EST_CONTAR_DESTRUIR(destruir)   ((destruir) = est_envolver_destruir (destruir))
+#define EST_RESERVAS(n)                 est_memoria ((n), 0)
+#define EST_LIBERACIONES(n)             est_memoria (0, (n))
+
+#else
+
+#define EST_INICIO                      ((void)0)
+#define EST_FIN(op)                     ((void)0)
+#define EST_NODOS(n)                    ((void)0)
+#define EST_CONTAR_COMPARAR(comparar)   ((void)0)
+#define EST_CONTAR_DESTRUIR(destruir)   ((void)0)
+#define EST_RESERVAS(n)                 ((void)0)
+#define EST_LIBERACIONES(n)             ((void)0)
+
+#endif
+
+#endif
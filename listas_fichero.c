@@ -0,0 +1,393 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "listas_fichero.h"
+
+// Los registros empiezan en múltiplos de 8 bytes
+#define ALINEAR(tam) (((tam) + 7) & ~(size_t)7)
+
+const char magia_fichero[4] = { 'L', 'S', 'T', 'B' };
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve distinto de cero si la cabecera es de una versión conocida
+// -----------------------------------------------------------------------------
+int cabecera_valida (TCabeceraFichero* cabecera)
+{
+	return (memcmp (cabecera->magia, magia_fichero, 4) == 0) &&
+	       (cabecera->version == FICHERO_LISTA_VERSION) &&
+	       (cabecera->n <= (uint64_t)INT32_MAX) &&
+	       (cabecera->primero >= sizeof(TCabeceraFichero)) &&
+	       (cabecera->primero % 8 == 0);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Escribe la cabecera y los registros de la lista en f
+//       Devuelve distinto de cero si algo falló
+// O(n)
+// -----------------------------------------------------------------------------
+int escribir_lista (TLista lista, FILE* f, FSerializar serializar, int tam_fijo)
+{
+	static const char ceros[8] = { 0 };
+	TCabeceraFichero cabecera;
+	TRegistroFichero registro;
+	TNodoLista* ptrnodo;
+	char* buffer;
+	char* mayor;
+	int capacidad, tam, error;
+	
+	memset (&cabecera, 0, sizeof(cabecera));
+	memcpy (cabecera.magia, magia_fichero, 4);
+	cabecera.version = FICHERO_LISTA_VERSION;
+	cabecera.tam_fijo = (tam_fijo > 0) ? tam_fijo : 0;
+	cabecera.primero = sizeof(TCabeceraFichero);
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		cabecera.n++;
+	error = (fwrite (&cabecera, sizeof(cabecera), 1, f) != 1);
+	
+	capacidad = 256;
+	buffer = (char*)malloc(capacidad);
+	if (buffer == NULL)
+		return 1;
+	for (ptrnodo = lista; (ptrnodo != NULL) && !error; ptrnodo = ptrnodo->next)
+	{
+		tam = serializar (ptrnodo->dato, buffer, capacidad);
+		if (tam > capacidad)
+		{
+			while (capacidad < tam)
+				capacidad *= 2;
+			mayor = (char*)realloc(buffer, capacidad);
+			if (mayor == NULL)
+			{
+				error = 1;
+				break;
+			}
+			buffer = mayor;
+			tam = serializar (ptrnodo->dato, buffer, capacidad);
+		}
+		
+		if ((tam < 0) || ((tam_fijo > 0) && (tam != tam_fijo)))
+		{
+			error = 1;
+			break;
+		}
+		
+		if (tam_fijo <= 0)
+		{
+			registro.tam = tam;
+			registro.siguiente = (ptrnodo->next != NULL) ? sizeof(registro) + ALINEAR(tam) : 0;
+			error |= (fwrite (&registro, sizeof(registro), 1, f) != 1);
+		}
+		error |= (fwrite (buffer, 1, tam, f) != (size_t)tam);
+		error |= (fwrite (ceros, 1, ALINEAR(tam) - tam, f) != ALINEAR(tam) - tam);
+	}
+	free (buffer);
+	
+	return error;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int guardar_lista (TLista lista, const char* fichero, FSerializar serializar, int tam_fijo)
+{
+	FILE* f;
+	char* temporal;
+	int error;
+	
+	// Se escribe aparte y se renombra al terminar: si algo falla el fichero
+	// anterior (si lo había) sigue intacto y no queda uno a medias
+	temporal = (char*)malloc(strlen (fichero) + 5);
+	if (temporal == NULL)
+		return -1;
+	strcpy (temporal, fichero);
+	strcat (temporal, ".tmp");
+	
+	f = fopen (temporal, "wb");
+	if (f == NULL)
+	{
+		free (temporal);
+		return -1;
+	}
+	
+	error = escribir_lista (lista, f, serializar, tam_fijo);
+	error |= (fclose (f) != 0);
+	error = error || (rename (temporal, fichero) != 0);
+	if (error)
+		unlink (temporal);
+	
+	free (temporal);
+	return error ? -1 : 0;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int cargar_lista (const char* fichero, FDeserializar deserializar, TPoolNodos* pool, TLista* lista)
+{
+	TCabeceraFichero cabecera;
+	TRegistroFichero registro;
+	TElemento* elementos;
+	struct stat info;
+	FILE* f;
+	char* buffer;
+	char* mayor;
+	uint64_t tam_fichero, pos, minimo;
+	size_t capacidad, tam;
+	int i, n, error;
+	
+	f = fopen (fichero, "rb");
+	if (f == NULL)
+		return -1;
+	
+	if ((fstat (fileno (f), &info) != 0) ||
+	    (fread (&cabecera, sizeof(cabecera), 1, f) != 1) || !cabecera_valida (&cabecera) ||
+	    (fseek (f, (long)cabecera.primero, SEEK_SET) != 0))
+	{
+		fclose (f);
+		return -1;
+	}
+	
+	// Lo mismo que comprueba mapear_lista, antes de reservar nada: cada
+	// elemento ocupa al menos su registro (o su tamaño fijo)
+	tam_fichero = (uint64_t)info.st_size;
+	minimo = (cabecera.tam_fijo > 0) ? ALINEAR((uint64_t)cabecera.tam_fijo) : sizeof(TRegistroFichero);
+	if ((cabecera.primero > tam_fichero) || (cabecera.n > (tam_fichero - cabecera.primero) / minimo))
+	{
+		fclose (f);
+		return -1;
+	}
+	
+	n = (int)cabecera.n;
+	elementos = (TElemento*)malloc((n > 0 ? n : 1) * sizeof(TElemento));
+	capacidad = (cabecera.tam_fijo > 0) ? ALINEAR(cabecera.tam_fijo) : 256;
+	buffer = (char*)malloc(capacidad);
+	
+	error = (elementos == NULL) || (buffer == NULL);
+	pos = cabecera.primero;
+	for (i=0; (i<n) && !error; i++)
+	{
+		if (cabecera.tam_fijo > 0)
+			tam = cabecera.tam_fijo;
+		else
+		{
+			error = (fread (&registro, sizeof(registro), 1, f) != 1);
+			tam = registro.tam;
+			pos += sizeof(registro);
+		}
+		
+		// Un registro que se sale del fichero está corrupto
+		if (error || (ALINEAR((uint64_t)tam) > tam_fichero - pos))
+		{
+			error = 1;
+			break;
+		}
+		pos += ALINEAR(tam);
+		
+		if (ALINEAR(tam) > capacidad)
+		{
+			capacidad = ALINEAR(tam);
+			mayor = (char*)realloc(buffer, capacidad);
+			if (mayor == NULL)
+			{
+				error = 1;
+				break;
+			}
+			buffer = mayor;
+		}
+		error = (fread (buffer, 1, ALINEAR(tam), f) != ALINEAR(tam));
+		if (!error)
+			elementos[i] = deserializar (buffer, (int)tam);
+	}
+	free (buffer);
+	fclose (f);
+	
+	// Los elementos ya creados quedan a cargo de deserializar (no hay FDestruir)
+	if (error)
+	{
+		free (elementos);
+		return -1;
+	}
+	
+	*lista = crear_lista_desde_array (elementos, n, pool);
+	free (elementos);
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TListaMapeada* mapear_lista (const char* fichero)
+{
+	TListaMapeada* lista;
+	TCabeceraFichero cabecera;
+	struct stat info;
+	void* base;
+	int fd;
+	
+	fd = open (fichero, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	
+	if ((fstat (fd, &info) != 0) || ((size_t)info.st_size < sizeof(TCabeceraFichero)))
+	{
+		close (fd);
+		return NULL;
+	}
+	
+	base = mmap (NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close (fd);
+	if (base == MAP_FAILED)
+		return NULL;
+	
+	// Con tamaño fijo el final se conoce sin recorrer, con tamaño variable
+	// cada paso del recorrido comprueba que no se sale del fichero
+	memcpy (&cabecera, base, sizeof(cabecera));
+	if (!cabecera_valida (&cabecera) ||
+	    ((cabecera.n > 0) && (cabecera.primero + sizeof(TRegistroFichero) > (uint64_t)info.st_size)) ||
+	    ((cabecera.tam_fijo > 0) &&
+	     (cabecera.primero + cabecera.n * ALINEAR((uint64_t)cabecera.tam_fijo) > (uint64_t)info.st_size)))
+	{
+		munmap (base, info.st_size);
+		return NULL;
+	}
+	
+	lista = (TListaMapeada*)malloc(sizeof(TListaMapeada));
+	lista->base = (const char*)base;
+	lista->tam_mapa = info.st_size;
+	lista->n = (int)cabecera.n;
+	lista->tam_fijo = cabecera.tam_fijo;
+	lista->primero = cabecera.primero;
+	
+	return lista;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la posición del registro que sigue al de la posición pos,
+//       o 0 si es el último o se saldría del fichero
+// O(1)
+// -----------------------------------------------------------------------------
+size_t siguiente_mapeado (TListaMapeada* lista, size_t pos)
+{
+	const TRegistroFichero* registro;
+	
+	// mapear_lista ya comprobó que los registros de tamaño fijo caben
+	if (lista->tam_fijo > 0)
+		return pos + ALINEAR((size_t)lista->tam_fijo);
+	
+	registro = (const TRegistroFichero*)(lista->base + pos);
+	if ((registro->siguiente == 0) || (registro->siguiente % 8 != 0))
+		return 0;
+	pos += registro->siguiente;
+	return (pos + sizeof(TRegistroFichero) <= lista->tam_mapa) ? pos : 0;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el elemento (puntero a sus bytes) del registro en pos, o
+//       NULL si sus bytes se salen del fichero
+// O(1)
+// -----------------------------------------------------------------------------
+TElemento elemento_mapeado (TListaMapeada* lista, size_t pos)
+{
+	const TRegistroFichero* registro;
+	
+	if (lista->tam_fijo > 0)
+		return (TElemento)(lista->base + pos);
+	
+	registro = (const TRegistroFichero*)(lista->base + pos);
+	if (pos + sizeof(TRegistroFichero) + registro->tam > lista->tam_mapa)
+		return NULL;
+	return (TElemento)(lista->base + pos + sizeof(TRegistroFichero));
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void recorrer_mapeada (TListaMapeada* lista, FMap map)
+{
+	TElemento e;
+	size_t pos;
+	int i;
+	
+	pos = lista->primero;
+	for (i=0; (i<lista->n) && (pos != 0); i++)
+	{
+		e = elemento_mapeado (lista, pos);
+		if (e == NULL)
+			break;
+		map (e);
+		pos = siguiente_mapeado (lista, pos);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int buscar_elemento_mapeada (TListaMapeada* lista, TElemento e, FComparar comparar)
+{
+	TElemento dato;
+	size_t pos;
+	int i, n;
+	
+	n = 0;
+	pos = lista->primero;
+	for (i=0; (i<lista->n) && (pos != 0); i++)
+	{
+		dato = elemento_mapeado (lista, pos);
+		if (dato == NULL)
+			break;
+		if (comparar (e, dato) == 0)
+			n++;
+		pos = siguiente_mapeado (lista, pos);
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+void desmapear_lista (TListaMapeada* lista)
+{
+	if (lista == NULL)
+		return;
+	
+	munmap ((void*)lista->base, lista->tam_mapa);
+	free (lista);
+}
@@ -0,0 +1,133 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_FICHERO_H
+#define LISTAS_FICHERO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Listas en fichero
+//
+// Formato (enteros en el orden de bytes de la máquina):
+//   cabecera: "LSTB", versión, tamaño fijo de elemento (0 si variable),
+//             número de elementos y posición del primer registro
+//   registros, empezando en múltiplos de 8 bytes:
+//     tamaño fijo:    los bytes del elemento
+//     tamaño variable: tamaño (uint32), distancia en bytes hasta el registro
+//                      siguiente (uint32, 0 en el último) y los bytes
+//
+// Los enlaces son distancias relativas y no punteros, así el fichero puede
+// proyectarse en memoria (mapear_lista) y recorrerse sin cargarlo
+// -----------------------------------------------------------------------------
+
+#define FICHERO_LISTA_VERSION 1
+
+typedef struct cabecera_fichero
+{
+	char     magia[4];
+	uint32_t version;
+	uint32_t tam_fijo;
+	uint32_t reservado;
+	uint64_t n;
+	uint64_t primero;
+} TCabeceraFichero;
+
+// Registro de tamaño variable, seguido de tam bytes
+typedef struct registro_fichero
+{
+	uint32_t tam;
+	uint32_t siguiente;
+} TRegistroFichero;
+
+// Lista proyectada en memoria de sólo lectura
+typedef struct lista_mapeada
+{
+	const char* base;
+	size_t      tam_mapa;
+	int         n;
+	int         tam_fijo;
+	size_t      primero;
+} TListaMapeada;
+
+// -----------------------------------------------------------------------------
+// Puntero a función que escribe un elemento en bytes
+// POST: Devuelve los bytes que ocupa e y, si caben en capacidad, los escribe
+//       en destino
+// -----------------------------------------------------------------------------
+typedef int (*FSerializar) (TElemento e, void* destino, int capacidad);
+
+// -----------------------------------------------------------------------------
+// Puntero a función que crea un elemento a partir de los tam bytes de origen
+// -----------------------------------------------------------------------------
+typedef TElemento (*FDeserializar) (const void* origen, int tam);
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Escribe la lista en el fichero. Si tam_fijo > 0 todos los elementos
+//       deben ocupar tam_fijo bytes, si no cada uno lleva su tamaño
+//       Se escribe en fichero.tmp y se renombra al terminar: si algo falla
+//       no queda un fichero a medias y el anterior no se toca
+//       Devuelve 0 si todo fue bien, -1 si no
+// O(n)
+// -----------------------------------------------------------------------------
+int guardar_lista (TLista lista, const char* fichero, FSerializar serializar, int tam_fijo);
+
+// -----------------------------------------------------------------------------
+// POST: Crea en *lista la lista guardada en el fichero con los elementos que
+//       devuelve deserializar, en el mismo orden. Si pool no es nulo los nodos
+//       salen de él con una sola reserva (como crear_lista_desde_array)
+//       Devuelve el número de elementos o -1 si el fichero no es válido
+//       (p.ej. tamaños que no caben en el fichero) o falta memoria
+// O(n)
+// -----------------------------------------------------------------------------
+int cargar_lista (const char* fichero, FDeserializar deserializar, TPoolNodos* pool, TLista* lista);
+
+// -----------------------------------------------------------------------------
+// POST: Proyecta el fichero en memoria de sólo lectura sin leerlo
+//       Devuelve NULL si no existe o no es válido
+// O(1)
+// -----------------------------------------------------------------------------
+TListaMapeada* mapear_lista (const char* fichero);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que recorrer. Cada elemento que recibe map es un puntero a sus
+//       bytes dentro del fichero, que no deben modificarse
+// -----------------------------------------------------------------------------
+void recorrer_mapeada (TListaMapeada* lista, FMap map);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que buscar_elemento. comparar recibe e y los punteros a los
+//       bytes de cada elemento
+// -----------------------------------------------------------------------------
+int buscar_elemento_mapeada (TListaMapeada* lista, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Deshace la proyección y libera la lista
+// -----------------------------------------------------------------------------
+void desmapear_lista (TListaMapeada* lista);
+
+#endif
@@ -0,0 +1,464 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "listas_indice.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+// Capacidad inicial de las tablas (potencia de 2) y su logaritmo en base 2
+#define INDICE_CAPACIDAD_INICIAL 16
+#define INDICE_BITS_INICIAL      4
+
+// Entradas del primer bloque, los siguientes son tan grandes como el índice
+#define INDICE_ENTRADAS_POR_BLOQUE (INDICE_CAPACIDAD_INICIAL / 2)
+
+// Entrada del índice: una por nodo
+typedef struct entrada_indice
+{
+	TNodoLista*             nodo;
+	TNodoLista**            enlace;     // NULL si el nodo es el primero
+	long long               orden;
+	unsigned int            hash;
+	struct entrada_indice*  sig;        // cadena de la cubeta
+	struct entrada_indice*  ant;
+} TEntradaIndice;
+
+// Hueco de la tabla por dirección de nodo (direccionamiento abierto)
+typedef struct hueco_nodo
+{
+	TNodoLista*     nodo;
+	TEntradaIndice* entrada;
+} THuecoNodo;
+
+// Bloque de entradas reservado de una sola vez
+typedef struct bloque_entradas
+{
+	struct bloque_entradas* sig;
+	TEntradaIndice          entradas[];
+} TBloqueEntradas;
+
+struct indice_hash
+{
+	FHash            hash;
+	FComparar        comparar;
+	int              n;             // entradas
+	long long        orden_cabeza;  // menor orden reservado
+	long long        orden_cola;    // siguiente orden libre por el final
+	int              capacidad;     // de las dos tablas, potencia de 2
+	int              bits;          // log2 de capacidad
+	TEntradaIndice** cubetas;       // por hash del elemento
+	THuecoNodo*      huecos;        // por dirección del nodo
+	TBloqueEntradas* bloques;       // el primero es el bloque en uso
+	int              usadas;        // entradas ya entregadas del bloque en uso
+	int              tam_bloque;    // entradas del bloque en uso
+	TEntradaIndice*  libres;        // entradas quitadas, enlazadas por sig
+};
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la posición inicial de nodo en la tabla de huecos
+// O(1)
+// -----------------------------------------------------------------------------
+int posicion_nodo (TIndiceHash* indice, TNodoLista* nodo)
+{
+	uint64_t h;
+	
+	h = (uint64_t)(uintptr_t)nodo * 0x9E3779B97F4A7C15ULL;
+	return (int)(h >> 32) & (indice->capacidad - 1);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la cubeta de un hash: los bits altos del producto de 64 bits,
+//       en los que influyen todos los bits del hash (por si la función de
+//       hash del usuario es pobre en los bits bajos)
+// O(1)
+// -----------------------------------------------------------------------------
+int cubeta_hash (TIndiceHash* indice, unsigned int hash)
+{
+	return (int)(((uint64_t)hash * 0x9E3779B97F4A7C15ULL) >> (64 - indice->bits));
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Reserva un bloque de n entradas, que pasa a ser el bloque en uso
+// O(1)
+// -----------------------------------------------------------------------------
+void nuevo_bloque_indice (TIndiceHash* indice, int n)
+{
+	TBloqueEntradas* bloque;
+	bloque = (TBloqueEntradas*)malloc(sizeof(TBloqueEntradas) + n * sizeof(TEntradaIndice));
+	
+	bloque->sig = indice->bloques;
+	indice->bloques = bloque;
+	indice->usadas = 0;
+	indice->tam_bloque = n;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve una entrada sin inicializar, primero de la lista libre y si
+//       está vacía del bloque en uso
+// O(1)
+// -----------------------------------------------------------------------------
+TEntradaIndice* nueva_entrada (TIndiceHash* indice)
+{
+	TEntradaIndice* entrada;
+	
+	if (indice->libres != NULL)
+	{
+		entrada = indice->libres;
+		indice->libres = entrada->sig;
+		return entrada;
+	}
+	
+	if ((indice->bloques == NULL) || (indice->usadas == indice->tam_bloque))
+		nuevo_bloque_indice (indice, (indice->n > INDICE_ENTRADAS_POR_BLOQUE) ? indice->n : INDICE_ENTRADAS_POR_BLOQUE);
+	
+	return &(indice->bloques->entradas[indice->usadas++]);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el hueco de nodo, o el hueco vacío donde iría
+// O(1) esperado
+// -----------------------------------------------------------------------------
+THuecoNodo* buscar_hueco (TIndiceHash* indice, TNodoLista* nodo)
+{
+	int i;
+	
+	i = posicion_nodo (indice, nodo);
+	while ((indice->huecos[i].nodo != NULL) && (indice->huecos[i].nodo != nodo))
+		i = (i + 1) & (indice->capacidad - 1);
+	return &(indice->huecos[i]);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Coloca la entrada en las dos tablas
+// O(1) esperado
+// -----------------------------------------------------------------------------
+void colocar_entrada (TIndiceHash* indice, TEntradaIndice* entrada)
+{
+	THuecoNodo* hueco;
+	int c;
+	
+	c = cubeta_hash (indice, entrada->hash);
+	entrada->ant = NULL;
+	entrada->sig = indice->cubetas[c];
+	if (entrada->sig != NULL)
+		entrada->sig->ant = entrada;
+	indice->cubetas[c] = entrada;
+	
+	hueco = buscar_hueco (indice, entrada->nodo);
+	hueco->nodo = entrada->nodo;
+	hueco->entrada = entrada;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Reserva tablas vacías de la capacidad dada
+// -----------------------------------------------------------------------------
+void reservar_tablas (TIndiceHash* indice, int capacidad, int bits)
+{
+	indice->capacidad = capacidad;
+	indice->bits = bits;
+	indice->cubetas = (TEntradaIndice**)calloc(capacidad, sizeof(TEntradaIndice*));
+	indice->huecos = (THuecoNodo*)calloc(capacidad, sizeof(THuecoNodo));
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Dobla la capacidad de las tablas y vuelve a colocar las entradas
+// O(n)
+// -----------------------------------------------------------------------------
+void crecer_indice (TIndiceHash* indice)
+{
+	TEntradaIndice** cubetas;
+	TEntradaIndice* entrada;
+	TEntradaIndice* sig;
+	int i, capacidad;
+	
+	cubetas = indice->cubetas;
+	capacidad = indice->capacidad;
+	free (indice->huecos);
+	reservar_tablas (indice, 2 * capacidad, indice->bits + 1);
+	
+	for (i=0; i<capacidad; i++)
+	{
+		for (entrada = cubetas[i]; entrada != NULL; entrada = sig)
+		{
+			sig = entrada->sig;
+			colocar_entrada (indice, entrada);
+		}
+	}
+	free (cubetas);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TIndiceHash* nuevo_indice (FHash hash, FComparar comparar)
+{
+	TIndiceHash* indice;
+	indice = (TIndiceHash*)malloc(sizeof(TIndiceHash));
+	
+	indice->hash = hash;
+	indice->comparar = comparar;
+	indice->n = 0;
+	indice->orden_cabeza = 0;
+	indice->orden_cola = 0;
+	indice->bloques = NULL;
+	indice->usadas = 0;
+	indice->tam_bloque = 0;
+	indice->libres = NULL;
+	reservar_tablas (indice, INDICE_CAPACIDAD_INICIAL, INDICE_BITS_INICIAL);
+	
+	return indice;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Libera los bloques de entradas siguientes a primero
+// O(b) siendo b el número de bloques
+// -----------------------------------------------------------------------------
+void liberar_bloques_indice (TBloqueEntradas* primero)
+{
+	TBloqueEntradas* bloque;
+	
+	while (primero->sig != NULL)
+	{
+		bloque = primero->sig;
+		primero->sig = bloque->sig;
+		free (bloque);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// Se conserva el bloque en uso, el mayor, para las entradas que se añadan
+// O(b + capacidad) siendo b el número de bloques
+// -----------------------------------------------------------------------------
+void vaciar_indice (TIndiceHash* indice)
+{
+	int i;
+	
+	for (i=0; i<indice->capacidad; i++)
+	{
+		indice->cubetas[i] = NULL;
+		indice->huecos[i].nodo = NULL;
+		indice->huecos[i].entrada = NULL;
+	}
+	if (indice->bloques != NULL)
+		liberar_bloques_indice (indice->bloques);
+	indice->usadas = 0;
+	indice->libres = NULL;
+	indice->n = 0;
+	indice->orden_cabeza = 0;
+	indice->orden_cola = 0;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(b + capacidad) siendo b el número de bloques
+// -----------------------------------------------------------------------------
+void liberar_indice (TIndiceHash* indice)
+{
+	if (indice == NULL)
+		return;
+	
+	vaciar_indice (indice);
+	free (indice->bloques);
+	free (indice->cubetas);
+	free (indice->huecos);
+	free (indice);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n + capacidad)
+// -----------------------------------------------------------------------------
+void indice_reservar (TIndiceHash* indice, int n)
+{
+	if (n < 1)
+		return;
+	
+	while (2 * (indice->n + n) > indice->capacidad)
+		crecer_indice (indice);
+	
+	if ((indice->bloques == NULL) || (indice->tam_bloque - indice->usadas < n))
+		nuevo_bloque_indice (indice, n);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+long long indice_orden_cabeza (TIndiceHash* indice, int n)
+{
+	indice->orden_cabeza -= n;
+	return indice->orden_cabeza;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+long long indice_orden_cola (TIndiceHash* indice)
+{
+	return indice->orden_cola++;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1) esperado
+// -----------------------------------------------------------------------------
+void indice_anadir (TIndiceHash* indice, TNodoLista* nodo, TNodoLista** enlace, long long orden)
+{
+	TEntradaIndice* entrada;
+	
+	// Factor de carga máximo 1/2 por el direccionamiento abierto
+	if (2 * (indice->n + 1) > indice->capacidad)
+		crecer_indice (indice);
+	
+	entrada = nueva_entrada (indice);
+	entrada->nodo = nodo;
+	entrada->enlace = enlace;
+	entrada->orden = orden;
+	entrada->hash = indice->hash (nodo->dato);
+	colocar_entrada (indice, entrada);
+	indice->n++;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1) esperado
+// -----------------------------------------------------------------------------
+void indice_quitar (TIndiceHash* indice, TNodoLista* nodo)
+{
+	TEntradaIndice* entrada;
+	THuecoNodo* hueco;
+	int i, j, k, mascara;
+	
+	hueco = buscar_hueco (indice, nodo);
+	entrada = hueco->entrada;
+	if (entrada == NULL)
+		return;
+	
+	// Fuera de la cadena de su cubeta
+	if (entrada->ant != NULL)
+		entrada->ant->sig = entrada->sig;
+	else
+		indice->cubetas[cubeta_hash (indice, entrada->hash)] = entrada->sig;
+	if (entrada->sig != NULL)
+		entrada->sig->ant = entrada->ant;
+	
+	// Borrado con desplazamiento hacia atrás: adelanta los huecos siguientes
+	// que quedarían inalcanzables desde su posición inicial
+	mascara = indice->capacidad - 1;
+	i = (int)(hueco - indice->huecos);
+	j = i;
+	while (1)
+	{
+		j = (j + 1) & mascara;
+		if (indice->huecos[j].nodo == NULL)
+			break;
+		k = posicion_nodo (indice, indice->huecos[j].nodo);
+		// Se mueve si k no está en el intervalo circular (i, j]
+		if ((i <= j) ? ((k <= i) || (k > j)) : ((k <= i) && (k > j)))
+		{
+			indice->huecos[i] = indice->huecos[j];
+			i = j;
+		}
+	}
+	indice->huecos[i].nodo = NULL;
+	indice->huecos[i].entrada = NULL;
+	
+	entrada->sig = indice->libres;
+	indice->libres = entrada;
+	indice->n--;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1) esperado
+// -----------------------------------------------------------------------------
+void indice_cambiar_enlace (TIndiceHash* indice, TNodoLista* nodo, TNodoLista** enlace)
+{
+	THuecoNodo* hueco;
+	
+	hueco = buscar_hueco (indice, nodo);
+	if (hueco->entrada != NULL)
+		hueco->entrada->enlace = enlace;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1 + coincidencias) esperado
+// -----------------------------------------------------------------------------
+int indice_contar (TIndiceHash* indice, TElemento e)
+{
+	TEntradaIndice* entrada;
+	unsigned int hash;
+	int n;
+	
+	hash = indice->hash (e);
+	n = 0;
+	for (entrada = indice->cubetas[cubeta_hash (indice, hash)]; entrada != NULL; entrada = entrada->sig)
+	{
+		if ((entrada->hash == hash) && (indice->comparar (e, entrada->nodo->dato) == 0))
+			n++;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1 + coincidencias) esperado
+// -----------------------------------------------------------------------------
+TNodoLista* indice_buscar (TIndiceHash* indice, TElemento e, int primero, TNodoLista*** ptrenlace)
+{
+	TEntradaIndice* entrada;
+	TEntradaIndice* res;
+	unsigned int hash;
+	
+	hash = indice->hash (e);
+	res = NULL;
+	for (entrada = indice->cubetas[cubeta_hash (indice, hash)]; entrada != NULL; entrada = entrada->sig)
+	{
+		if ((entrada->hash == hash) && (indice->comparar (e, entrada->nodo->dato) == 0) &&
+		    ((res == NULL) || (entrada->orden < res->orden)))
+		{
+			res = entrada;
+			if (!primero)
+				break;
+		}
+	}
+	
+	if (res == NULL)
+		return NULL;
+	
+	*ptrenlace = res->enlace;
+	return res->nodo;
+}
@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_INDICE_H
+#define LISTAS_INDICE_H
+
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Índice hash de una lista con cabecera (uso interno de listas.c)
+//
+// Guarda una entrada por nodo con el enlace que apunta a él (el next de su
+// predecesor, o NULL si es el primero) y su orden en la lista. Las entradas
+// están a la vez en una tabla por hash del elemento, para buscar por clave,
+// y en una tabla por dirección del nodo, para actualizar el enlace de un
+// nodo cuando cambia su predecesor. El orden permite saber cuál de varias
+// coincidencias va antes en la lista sin recorrerla. Las entradas se reservan
+// por bloques y las que se quitan se reutilizan
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// POST: Crea un índice vacío
+// -----------------------------------------------------------------------------
+TIndiceHash* nuevo_indice (FHash hash, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Quita todas las entradas del índice
+// -----------------------------------------------------------------------------
+void vaciar_indice (TIndiceHash* indice);
+
+// -----------------------------------------------------------------------------
+// POST: Libera el índice y sus entradas
+// -----------------------------------------------------------------------------
+void liberar_indice (TIndiceHash* indice);
+
+// -----------------------------------------------------------------------------
+// POST: Prepara el índice para n entradas más: agranda las tablas y reserva
+//       de una vez las entradas, para que añadirlas no reserve memoria
+// O(n + capacidad)
+// -----------------------------------------------------------------------------
+void indice_reservar (TIndiceHash* indice, int n);
+
+// -----------------------------------------------------------------------------
+// POST: Reserva n órdenes delante del primero y devuelve el menor, para los
+//       nodos que se van a añadir por la cabeza
+// O(1)
+// -----------------------------------------------------------------------------
+long long indice_orden_cabeza (TIndiceHash* indice, int n);
+
+// -----------------------------------------------------------------------------
+// POST: Reserva y devuelve un orden detrás del último, para un nodo que se va
+//       a añadir por el final
+// O(1)
+// -----------------------------------------------------------------------------
+long long indice_orden_cola (TIndiceHash* indice);
+
+// -----------------------------------------------------------------------------
+// PRE: nodo no está en el índice
+// POST: Añade nodo, al que apunta enlace (NULL si es el primero) y que ocupa
+//       la posición orden (los órdenes crecen de la cabeza a la cola)
+// O(1) esperado
+// -----------------------------------------------------------------------------
+void indice_anadir (TIndiceHash* indice, TNodoLista* nodo, TNodoLista** enlace, long long orden);
+
+// -----------------------------------------------------------------------------
+// POST: Quita nodo del índice
+// O(1) esperado
+// -----------------------------------------------------------------------------
+void indice_quitar (TIndiceHash* indice, TNodoLista* nodo);
+
+// -----------------------------------------------------------------------------
+// POST: Cambia el enlace que apunta a nodo
+// O(1) esperado
+// -----------------------------------------------------------------------------
+void indice_cambiar_enlace (TIndiceHash* indice, TNodoLista* nodo, TNodoLista** enlace);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el número de nodos cuyo elemento coincide con e
+// O(1 + coincidencias) esperado
+// -----------------------------------------------------------------------------
+int indice_contar (TIndiceHash* indice, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve un nodo cuyo elemento coincide con e, el primero en el orden
+//       de la lista si primero!=0, o NULL si no hay. En *ptrenlace deja el
+//       enlace que apunta a él
+// O(1 + coincidencias) esperado
+// -----------------------------------------------------------------------------
+TNodoLista* indice_buscar (TIndiceHash* indice, TElemento e, int primero, TNodoLista*** ptrenlace);
+
+#endif
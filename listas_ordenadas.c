@@ -0,0 +1,279 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "listas_ordenadas.h"
+#include <stdlib.h>
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TListaOrdenada* crear_lista_ordenada (FComparar comparar)
+{
+	TListaOrdenada* lista;
+	int i;
+	
+	lista = (TListaOrdenada*)malloc(sizeof(TListaOrdenada));
+	lista->cabeza = crear_lista_vacia();
+	lista->longitud = 0;
+	lista->comparar = comparar;
+	lista->niveles = 0;
+	for (i=0; i<ORDENADA_NIVELES; i++)
+		lista->primeros[i] = NULL;
+	lista->semilla = 0x9E3779B9U;
+	
+	return lista;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Sortea el número de carriles de un nodo nuevo: h con probabilidad
+//       (3/4)(1/4)^h
+// O(1)
+// -----------------------------------------------------------------------------
+int sortear_niveles (TListaOrdenada* lista)
+{
+	unsigned int r;
+	int h;
+	
+	// xorshift32
+	r = lista->semilla;
+	r ^= r << 13;
+	r ^= r >> 17;
+	r ^= r << 5;
+	lista->semilla = r;
+	
+	h = 0;
+	while (((r & 3) == 0) && (h < ORDENADA_NIVELES))
+	{
+		h++;
+		r >>= 2;
+	}
+	return h;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve distinto de cero si un nodo con dato va antes de la posición
+//       buscada para e: dato < e, o dato <= e si despues!=0
+// -----------------------------------------------------------------------------
+int va_antes (TListaOrdenada* lista, TElemento dato, TElemento e, int despues)
+{
+	int c;
+	
+	c = lista->comparar (dato, e);
+	return (c < 0) || (despues && (c == 0));
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el puntero al puntero que apunta al primer nodo que no va
+//       antes de e (ver va_antes). Si previos no es nulo deja en previos[i]
+//       el último nodo expreso del carril i+1 que va antes de e (NULL si no
+//       hay ninguno)
+// O(log n) esperado
+// -----------------------------------------------------------------------------
+TNodoLista** localizar_ordenado (TListaOrdenada* lista, TElemento e, int despues, TExpreso** previos)
+{
+	TExpreso* ptrexpreso;
+	TExpreso* sig;
+	TNodoLista** ptrptrnodo;
+	int i;
+	
+	ptrexpreso = NULL;
+	for (i = lista->niveles - 1; i >= 0; i--)
+	{
+		sig = (ptrexpreso == NULL) ? lista->primeros[i] : ptrexpreso->sig[i];
+		while ((sig != NULL) && va_antes (lista, sig->nodo->dato, e, despues))
+		{
+			ptrexpreso = sig;
+			sig = sig->sig[i];
+		}
+		if (previos != NULL)
+			previos[i] = ptrexpreso;
+	}
+	
+	// Últimos pasos por la TLista
+	ptrptrnodo = (ptrexpreso == NULL) ? &(lista->cabeza) : &(ptrexpreso->nodo->next);
+	while ((*ptrptrnodo != NULL) && va_antes (lista, (*ptrptrnodo)->dato, e, despues))
+		ptrptrnodo = &((*ptrptrnodo)->next);
+	
+	return ptrptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(log n) esperado
+// -----------------------------------------------------------------------------
+void insertar_ordenado (TListaOrdenada* lista, TElemento e)
+{
+	TExpreso* previos[ORDENADA_NIVELES];
+	TExpreso* ptrexpreso;
+	TNodoLista** ptrptrnodo;
+	int i, h;
+	
+	ptrptrnodo = localizar_ordenado (lista, e, 1, previos);
+	insertar_elemento (ptrptrnodo, e);
+	lista->longitud++;
+	
+	h = sortear_niveles (lista);
+	if (h == 0)
+		return;
+	
+	ptrexpreso = (TExpreso*)malloc(sizeof(TExpreso) + h * sizeof(TExpreso*));
+	ptrexpreso->nodo = *ptrptrnodo;
+	for (i = lista->niveles; i < h; i++)
+		previos[i] = NULL;
+	if (h > lista->niveles)
+		lista->niveles = h;
+	
+	for (i=0; i<h; i++)
+	{
+		if (previos[i] == NULL)
+		{
+			ptrexpreso->sig[i] = lista->primeros[i];
+			lista->primeros[i] = ptrexpreso;
+		}
+		else
+		{
+			ptrexpreso->sig[i] = previos[i]->sig[i];
+			previos[i]->sig[i] = ptrexpreso;
+		}
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O(log n + ocurrencias) esperado
+// -----------------------------------------------------------------------------
+int buscar_ordenado (TListaOrdenada* lista, TElemento e)
+{
+	TNodoLista* ptrnodo;
+	int n;
+	
+	ptrnodo = *localizar_ordenado (lista, e, 0, NULL);
+	
+	n = 0;
+	while ((ptrnodo != NULL) && (lista->comparar (e, ptrnodo->dato) == 0))
+	{
+		n++;
+		ptrnodo = ptrnodo->next;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: previos son los de localizar_ordenado para el elemento del nodo
+//      (antes de él en todos los carriles)
+// POST: Quita de los carriles el nodo expreso de ptrnodo, si lo tiene
+// O(niveles)
+// -----------------------------------------------------------------------------
+void quitar_expreso (TListaOrdenada* lista, TNodoLista* ptrnodo, TExpreso** previos)
+{
+	TExpreso** ptrptrexpreso;
+	TExpreso* ptrexpreso;
+	int i;
+	
+	ptrexpreso = NULL;
+	for (i=0; i<lista->niveles; i++)
+	{
+		ptrptrexpreso = (previos[i] == NULL) ? &(lista->primeros[i]) : &(previos[i]->sig[i]);
+		if ((*ptrptrexpreso == NULL) || ((*ptrptrexpreso)->nodo != ptrnodo))
+			break;
+		ptrexpreso = *ptrptrexpreso;
+		*ptrptrexpreso = ptrexpreso->sig[i];
+	}
+	free (ptrexpreso);
+	
+	while ((lista->niveles > 0) && (lista->primeros[lista->niveles - 1] == NULL))
+		lista->niveles--;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(log n + ocurrencias) esperado
+// -----------------------------------------------------------------------------
+int borrar_ordenado (TListaOrdenada* lista, TElemento e, int todos, FDestruir destruir)
+{
+	TExpreso* previos[ORDENADA_NIVELES];
+	TNodoLista** ptrptrnodo;
+	TNodoLista* ptrnodo;
+	int n;
+	
+	// Los previos van antes de todas las coincidencias, sirven para todas
+	ptrptrnodo = localizar_ordenado (lista, e, 0, previos);
+	
+	n = 0;
+	while ((*ptrptrnodo != NULL) && (lista->comparar (e, (*ptrptrnodo)->dato) == 0))
+	{
+		ptrnodo = *ptrptrnodo;
+		quitar_expreso (lista, ptrnodo, previos);
+		*ptrptrnodo = ptrnodo->next;
+		destruir (ptrnodo->dato);
+		free (ptrnodo);
+		lista->longitud--;
+		n++;
+		if (!todos)
+			break;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(log n + elementos del rango) esperado
+// -----------------------------------------------------------------------------
+void recorrer_rango (TListaOrdenada* lista, TElemento desde, TElemento hasta, FMap map)
+{
+	TNodoLista* ptrnodo;
+	
+	ptrnodo = *localizar_ordenado (lista, desde, 0, NULL);
+	while ((ptrnodo != NULL) && (lista->comparar (ptrnodo->dato, hasta) <= 0))
+	{
+		map (ptrnodo->dato);
+		ptrnodo = ptrnodo->next;
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void destruir_lista_ordenada (TListaOrdenada* lista, FDestruir destruir)
+{
+	TExpreso* ptrexpreso;
+	TExpreso* sig;
+	
+	// Todos los nodos expresos están en el primer carril
+	if (lista->niveles > 0)
+	{
+		for (ptrexpreso = lista->primeros[0]; ptrexpreso != NULL; ptrexpreso = sig)
+		{
+			sig = ptrexpreso->sig[0];
+			free (ptrexpreso);
+		}
+	}
+	destruir_lista (&(lista->cabeza), destruir);
+	free (lista);
+}
@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_ORDENADAS_H
+#define LISTAS_ORDENADAS_H
+
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Lista ordenada (skip list)
+//
+// Los elementos forman una TLista normal ordenada según comparar, y encima
+// hay carriles expresos: cada nodo tiene con probabilidad 1/4 un nodo expreso
+// de nivel 1, con 1/16 de nivel 2, etc. Un nodo expreso de nivel h enlaza
+// con el siguiente de su nivel en cada uno de los h carriles, así las
+// búsquedas bajan de carril en carril en O(log n) esperado y sólo recorren
+// unos pocos nodos de la TLista al final
+//
+// cabeza puede pasarse a buscar_elemento, recorrer, etc. pero la lista sólo
+// debe modificarse con las operaciones de este módulo
+// -----------------------------------------------------------------------------
+
+// Número máximo de carriles expresos
+#define ORDENADA_NIVELES 16
+
+// Nodo de los carriles expresos, sig[i] es el siguiente en el carril i+1
+typedef struct expreso
+{
+	TNodoLista*     nodo;
+	struct expreso* sig[];
+} TExpreso;
+
+typedef struct lista_ordenada
+{
+	TLista       cabeza;
+	int          longitud;
+	FComparar    comparar;
+	int          niveles;                       // carriles en uso
+	TExpreso*    primeros[ORDENADA_NIVELES];    // primer nodo de cada carril
+	unsigned int semilla;                       // para sortear los niveles
+} TListaOrdenada;
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve una lista ordenada vacía según comparar
+// -----------------------------------------------------------------------------
+TListaOrdenada* crear_lista_ordenada (FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Inserta e en su posición, detrás de los elementos iguales a él
+// O(log n) esperado
+// -----------------------------------------------------------------------------
+void insertar_ordenado (TListaOrdenada* lista, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que buscar_elemento, devuelve el número de ocurrencias de e
+// O(log n + ocurrencias) esperado
+// -----------------------------------------------------------------------------
+int buscar_ordenado (TListaOrdenada* lista, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que borrar_elemento: borra el primer elemento igual a e, o
+//       todos si todos!=0, destruyéndolos con destruir
+//       Devuelve el número de elementos borrados
+// O(log n + ocurrencias) esperado
+// -----------------------------------------------------------------------------
+int borrar_ordenado (TListaOrdenada* lista, TElemento e, int todos, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Aplica map, en orden, a los elementos x tales que desde <= x <= hasta
+// O(log n + elementos del rango) esperado
+// -----------------------------------------------------------------------------
+void recorrer_rango (TListaOrdenada* lista, TElemento desde, TElemento hasta, FMap map);
+
+// -----------------------------------------------------------------------------
+// POST: Destruye los elementos con destruir y libera la lista
+// -----------------------------------------------------------------------------
+void destruir_lista_ordenada (TListaOrdenada* lista, FDestruir destruir);
+
+#endif
@@ -0,0 +1,516 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "listas_paralelas.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// Tramos por hilo en los que se intenta partir la lista
+#define TRAMOS_POR_HILO 16
+
+// Por debajo de esta longitud ordenar_lista_paralelo ordena en un solo hilo
+#define UMBRAL_ORDENAR_PARALELO 65536
+
+// Trabajo repartido entre los hilos
+typedef struct trabajo
+{
+	TNodoLista**      inicios;        // tramo i: de inicios[i] a inicios[i+1]
+	int               ntramos;
+	int               participantes;
+	_Atomic uint64_t* grupos;         // tramos pendientes de cada participante
+	void (*procesar) (struct trabajo* t, int tramo);
+	FMap              map;
+	FReducir          reducir;
+	TElemento         identidad;
+	TElemento*        resultados;     // resultado de cada tramo al reducir
+	FComparar         comparar;
+	TNodoLista**      cabezas;        // tramos ordenados al ordenar
+	int               ancho;          // tramos ya mezclados en cada cabeza
+	int               ntramos_ordenados;
+	int               siguiente;      // próximo participante que se asigna
+	int               dentro;         // hilos del pool trabajando en él
+} TTrabajo;
+
+// Pool de hilos compartido por todas las operaciones paralelas
+typedef struct pool_hilos
+{
+	pthread_mutex_t cerrojo;
+	pthread_cond_t  hay_trabajo;
+	pthread_cond_t  terminado;
+	pthread_mutex_t llamadas;       // un trabajo cada vez
+	pthread_t*      hilos;
+	int             nhilos;
+	int             salir;
+	TTrabajo*       trabajo;
+	unsigned        generacion;     // cambia con cada trabajo
+} TPoolHilos;
+
+TPoolHilos pool_hilos = {
+	PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+	PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0, NULL, 0
+};
+
+// Distinto de 0 en los hilos que están procesando tramos de un trabajo: una
+// operación paralela llamada desde map, reducir o comparar se hace entera en
+// ese hilo, porque esperar al cerrojo de llamadas no acabaría nunca
+_Thread_local int en_trabajo = 0;
+
+
+// -----------------------------------------------------------------------------
+// PRE: max >= 2
+// POST: Parte la lista en una sola pasada en entre max/2 y max tramos (menos
+//       si no hay tantos nodos) y devuelve sus primeros nodos seguidos de
+//       NULL. Se guarda un nodo de cada paso; si se llena el vector se
+//       descartan los impares y se dobla el paso
+// O(n)
+// -----------------------------------------------------------------------------
+TNodoLista** partir_en_tramos (TLista lista, int max, int* ptrntramos)
+{
+	TNodoLista** inicios;
+	TNodoLista* ptrnodo;
+	long i, paso;
+	int j, n;
+	
+	inicios = (TNodoLista**)malloc((max + 1) * sizeof(TNodoLista*));
+	n = 0;
+	paso = 1;
+	for (ptrnodo = lista, i = 0; ptrnodo != NULL; ptrnodo = ptrnodo->next, i++)
+	{
+		if (i % paso != 0)
+			continue;
+		if (n == max)
+		{
+			for (j=0; 2*j < n; j++)
+				inicios[j] = inicios[2*j];
+			n = j;
+			paso *= 2;
+			if (i % paso != 0)
+				continue;
+		}
+		inicios[n++] = ptrnodo;
+	}
+	inicios[n] = NULL;
+	
+	*ptrntramos = n;
+	return inicios;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve un tramo pendiente para el participante p, primero del
+//       principio de su grupo y si está vacío del final del de otro.
+//       Devuelve -1 si no queda ninguno
+//       Cada grupo es un entero de 64 bits (inicio << 32 | fin) que se
+//       modifica con CAS, así el dueño y los ladrones no se pisan
+// O(participantes)
+// -----------------------------------------------------------------------------
+int tomar_tramo (TTrabajo* t, int p)
+{
+	uint64_t grupo, nuevo;
+	uint32_t ini, fin;
+	int i, q;
+	
+	grupo = atomic_load (&(t->grupos[p]));
+	while (1)
+	{
+		ini = (uint32_t)(grupo >> 32);
+		fin = (uint32_t)grupo;
+		if (ini >= fin)
+			break;
+		nuevo = ((uint64_t)(ini + 1) << 32) | fin;
+		if (atomic_compare_exchange_weak (&(t->grupos[p]), &grupo, nuevo))
+			return (int)ini;
+	}
+	
+	for (i=1; i<t->participantes; i++)
+	{
+		q = (p + i) % t->participantes;
+		grupo = atomic_load (&(t->grupos[q]));
+		while (1)
+		{
+			ini = (uint32_t)(grupo >> 32);
+			fin = (uint32_t)grupo;
+			if (ini >= fin)
+				break;
+			nuevo = ((uint64_t)ini << 32) | (fin - 1);
+			if (atomic_compare_exchange_weak (&(t->grupos[q]), &grupo, nuevo))
+				return (int)(fin - 1);
+		}
+	}
+	return -1;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Procesa tramos como participante p hasta que no queda ninguno
+// -----------------------------------------------------------------------------
+void participar (TTrabajo* t, int p)
+{
+	int tramo;
+	
+	while ((tramo = tomar_tramo (t, p)) >= 0)
+		t->procesar (t, tramo);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Bucle de cada hilo del pool: espera un trabajo nuevo, toma un número
+//       de participante si aún quedan y trabaja en él
+// -----------------------------------------------------------------------------
+void* hilo_pool (void* arg)
+{
+	TTrabajo* t;
+	unsigned visto;
+	int p;
+	
+	(void)arg;
+	en_trabajo = 1;
+	visto = 0;
+	pthread_mutex_lock (&(pool_hilos.cerrojo));
+	while (1)
+	{
+		while (!pool_hilos.salir &&
+		       ((pool_hilos.trabajo == NULL) || (pool_hilos.generacion == visto)))
+			pthread_cond_wait (&(pool_hilos.hay_trabajo), &(pool_hilos.cerrojo));
+		
+		if (pool_hilos.salir)
+			break;
+		
+		t = pool_hilos.trabajo;
+		visto = pool_hilos.generacion;
+		if (t->siguiente >= t->participantes)
+			continue;
+		
+		p = t->siguiente++;
+		t->dentro++;
+		pthread_mutex_unlock (&(pool_hilos.cerrojo));
+		
+		participar (t, p);
+		
+		pthread_mutex_lock (&(pool_hilos.cerrojo));
+		if (--t->dentro == 0)
+			pthread_cond_broadcast (&(pool_hilos.terminado));
+	}
+	pthread_mutex_unlock (&(pool_hilos.cerrojo));
+	return NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: Se tiene el cerrojo de llamadas
+// POST: Asegura que el pool tiene al menos n hilos
+// -----------------------------------------------------------------------------
+void asegurar_hilos (int n)
+{
+	if (n <= pool_hilos.nhilos)
+		return;
+	
+	pool_hilos.hilos = (pthread_t*)realloc(pool_hilos.hilos, n * sizeof(pthread_t));
+	while (pool_hilos.nhilos < n)
+	{
+		if (pthread_create (&(pool_hilos.hilos[pool_hilos.nhilos]), NULL, hilo_pool, NULL) != 0)
+			break;
+		pool_hilos.nhilos++;
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Reparte los tramos de t entre el hilo que llama y hasta hilos-1
+//       hilos del pool y vuelve cuando están todos procesados
+//       Llamado desde un hilo que ya procesa tramos los procesa él solo
+// -----------------------------------------------------------------------------
+void ejecutar_trabajo (TTrabajo* t, int hilos)
+{
+	int i, ini, fin;
+	
+	if (en_trabajo)
+	{
+		for (i=0; i<t->ntramos; i++)
+			t->procesar (t, i);
+		return;
+	}
+	
+	pthread_mutex_lock (&(pool_hilos.llamadas));
+	asegurar_hilos (hilos - 1);
+	
+	// Nunca más participantes que hilos disponibles o que tramos
+	t->participantes = pool_hilos.nhilos + 1;
+	if (t->participantes > hilos)
+		t->participantes = hilos;
+	if (t->participantes > t->ntramos)
+		t->participantes = t->ntramos;
+	
+	// Grupos iniciales de tramos consecutivos del mismo tamaño
+	t->grupos = (_Atomic uint64_t*)malloc(t->participantes * sizeof(_Atomic uint64_t));
+	for (i=0; i<t->participantes; i++)
+	{
+		ini = (int)((long)t->ntramos * i / t->participantes);
+		fin = (int)((long)t->ntramos * (i + 1) / t->participantes);
+		atomic_init (&(t->grupos[i]), ((uint64_t)ini << 32) | (uint32_t)fin);
+	}
+	t->siguiente = 1;
+	t->dentro = 0;
+	
+	pthread_mutex_lock (&(pool_hilos.cerrojo));
+	pool_hilos.trabajo = t;
+	pool_hilos.generacion++;
+	pthread_cond_broadcast (&(pool_hilos.hay_trabajo));
+	pthread_mutex_unlock (&(pool_hilos.cerrojo));
+	
+	en_trabajo = 1;
+	participar (t, 0);
+	en_trabajo = 0;
+	
+	// Todos los tramos están tomados: se espera a los que siguen en curso
+	pthread_mutex_lock (&(pool_hilos.cerrojo));
+	while (t->dentro > 0)
+		pthread_cond_wait (&(pool_hilos.terminado), &(pool_hilos.cerrojo));
+	pool_hilos.trabajo = NULL;
+	pthread_mutex_unlock (&(pool_hilos.cerrojo));
+	
+	pthread_mutex_unlock (&(pool_hilos.llamadas));
+	free (t->grupos);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Aplica map a los nodos del tramo
+// -----------------------------------------------------------------------------
+void procesar_recorrido (TTrabajo* t, int tramo)
+{
+	TNodoLista* ptrnodo;
+	
+	for (ptrnodo = t->inicios[tramo]; ptrnodo != t->inicios[tramo+1]; ptrnodo = ptrnodo->next)
+		t->map (ptrnodo->dato);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Reduce los elementos del tramo y guarda su resultado
+// -----------------------------------------------------------------------------
+void procesar_reduccion (TTrabajo* t, int tramo)
+{
+	TNodoLista* ptrnodo;
+	TElemento acumulado;
+	
+	acumulado = t->identidad;
+	for (ptrnodo = t->inicios[tramo]; ptrnodo != t->inicios[tramo+1]; ptrnodo = ptrnodo->next)
+		acumulado = t->reducir (acumulado, ptrnodo->dato);
+	t->resultados[tramo] = acumulado;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Separa el tramo de la lista (terminándolo en NULL) y lo ordena
+// -----------------------------------------------------------------------------
+void procesar_ordenacion (TTrabajo* t, int tramo)
+{
+	TNodoLista* ptrnodo;
+	
+	ptrnodo = t->inicios[tramo];
+	while (ptrnodo->next != t->inicios[tramo+1])
+		ptrnodo = ptrnodo->next;
+	ptrnodo->next = NULL;
+	
+	t->cabezas[tramo] = t->inicios[tramo];
+	ordenar_lista (&(t->cabezas[tramo]), t->comparar);
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Mezcla de forma estable (ante iguales primero los de a) las listas
+//       ordenadas a y b y devuelve el resultado
+// O(n)
+// -----------------------------------------------------------------------------
+TNodoLista* mezclar_tramos (TNodoLista* a, TNodoLista* b, FComparar comparar)
+{
+	TNodoLista* res;
+	TNodoLista** ptrptrnodo;
+	
+	ptrptrnodo = &res;
+	while ((a != NULL) && (b != NULL))
+	{
+		if (comparar(a->dato, b->dato) <= 0)
+		{
+			*ptrptrnodo = a;
+			ptrptrnodo = &(a->next);
+			a = a->next;
+		}
+		else
+		{
+			*ptrptrnodo = b;
+			ptrptrnodo = &(b->next);
+			b = b->next;
+		}
+	}
+	*ptrptrnodo = (a != NULL) ? a : b;
+	return res;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Mezcla la pareja de tramos ordenados número tramo del nivel actual
+//       del árbol de mezclas: cabezas[2*tramo*ancho] y la que está ancho
+//       posiciones detrás, si la hay
+// -----------------------------------------------------------------------------
+void procesar_mezcla (TTrabajo* t, int tramo)
+{
+	int i;
+	
+	i = 2 * tramo * t->ancho;
+	if (i + t->ancho < t->ntramos_ordenados)
+		t->cabezas[i] = mezclar_tramos (t->cabezas[i], t->cabezas[i + t->ancho], t->comparar);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n / hilos) si el coste de map es parecido en todos los elementos
+// -----------------------------------------------------------------------------
+void recorrer_paralelo (TLista lista, FMap map, int hilos)
+{
+	TTrabajo t;
+	
+	if (hilos < 2)
+	{
+		recorrer (lista, map);
+		return;
+	}
+	
+	t.inicios = partir_en_tramos (lista, hilos * TRAMOS_POR_HILO, &(t.ntramos));
+	if (t.ntramos > 0)
+	{
+		t.procesar = procesar_recorrido;
+		t.map = map;
+		ejecutar_trabajo (&t, hilos);
+	}
+	free (t.inicios);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n / hilos) si el coste de reducir es parecido en todos los elementos
+// -----------------------------------------------------------------------------
+TElemento reducir_paralelo (TLista lista, FReducir reducir, TElemento identidad, int hilos)
+{
+	TTrabajo t;
+	TElemento res;
+	int i;
+	
+	if (hilos < 1)
+		hilos = 1;
+	
+	t.inicios = partir_en_tramos (lista, hilos * TRAMOS_POR_HILO, &(t.ntramos));
+	t.procesar = procesar_reduccion;
+	t.reducir = reducir;
+	t.identidad = identidad;
+	t.resultados = (TElemento*)malloc((t.ntramos + 1) * sizeof(TElemento));
+	
+	if (hilos == 1)
+	{
+		for (i=0; i<t.ntramos; i++)
+			procesar_reduccion (&t, i);
+	}
+	else if (t.ntramos > 0)
+		ejecutar_trabajo (&t, hilos);
+	
+	// Los resultados de los tramos se combinan en el orden de la lista
+	res = identidad;
+	for (i=0; i<t.ntramos; i++)
+		res = reducir (res, t.resultados[i]);
+	
+	free (t.resultados);
+	free (t.inicios);
+	return res;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log n / hilos + n)
+// -----------------------------------------------------------------------------
+void ordenar_lista_paralelo (TLista* ptrlista, FComparar comparar, int hilos)
+{
+	TTrabajo t;
+	TNodoLista* ptrnodo;
+	long n;
+	
+	n = 0;
+	for (ptrnodo = *ptrlista; (ptrnodo != NULL) && (n < UMBRAL_ORDENAR_PARALELO); ptrnodo = ptrnodo->next)
+		n++;
+	
+	if ((hilos < 2) || (n < UMBRAL_ORDENAR_PARALELO))
+	{
+		ordenar_lista (ptrlista, comparar);
+		return;
+	}
+	
+	// Entre hilos y 2*hilos tramos consecutivos que se ordenan a la vez
+	t.inicios = partir_en_tramos (*ptrlista, 2 * hilos, &(t.ntramos));
+	t.cabezas = (TNodoLista**)malloc(t.ntramos * sizeof(TNodoLista*));
+	t.comparar = comparar;
+	t.ntramos_ordenados = t.ntramos;
+	t.procesar = procesar_ordenacion;
+	ejecutar_trabajo (&t, hilos);
+	
+	// Árbol de mezclas: en cada nivel las parejas de tramos vecinos se mezclan
+	// a la vez. Mezclar siempre un tramo con el siguiente conserva la
+	// estabilidad y da el mismo resultado que ordenar_lista
+	t.procesar = procesar_mezcla;
+	for (t.ancho = 1; t.ancho < t.ntramos_ordenados; t.ancho *= 2)
+	{
+		t.ntramos = (t.ntramos_ordenados + 2 * t.ancho - 1) / (2 * t.ancho);
+		ejecutar_trabajo (&t, hilos);
+	}
+	
+	*ptrlista = t.cabezas[0];
+	free (t.cabezas);
+	free (t.inicios);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(hilos)
+// -----------------------------------------------------------------------------
+void terminar_hilos_paralelos (void)
+{
+	int i;
+	
+	pthread_mutex_lock (&(pool_hilos.llamadas));
+	
+	pthread_mutex_lock (&(pool_hilos.cerrojo));
+	pool_hilos.salir = 1;
+	pthread_cond_broadcast (&(pool_hilos.hay_trabajo));
+	pthread_mutex_unlock (&(pool_hilos.cerrojo));
+	
+	for (i=0; i<pool_hilos.nhilos; i++)
+		pthread_join (pool_hilos.hilos[i], NULL);
+	
+	free (pool_hilos.hilos);
+	pool_hilos.hilos = NULL;
+	pool_hilos.nhilos = 0;
+	pool_hilos.salir = 0;
+	
+	pthread_mutex_unlock (&(pool_hilos.llamadas));
+}
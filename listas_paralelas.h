@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_PARALELAS_H
+#define LISTAS_PARALELAS_H
+
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Recorridos en paralelo
+// La lista se parte en tramos en una sola pasada y los tramos se reparten
+// entre el hilo que llama y un pool de hilos que se crea la primera vez y se
+// reutiliza en las siguientes llamadas. Cada hilo empieza con un grupo de
+// tramos consecutivos y, cuando lo termina, roba tramos del final de los
+// grupos de los demás, así un map de coste desigual no deja hilos parados
+// Mientras dura un recorrido paralelo la lista no debe modificarse
+// Las llamadas desde distintos hilos se atienden de una en una. Una operación
+// paralela llamada desde map, reducir o comparar no se reparte: se hace
+// entera en el hilo que la llama, como con hilos < 2
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// Puntero a función que acumula e sobre acumulado y devuelve el resultado
+// Debe ser asociativa y tener un elemento neutro (identidad):
+//   reducir(reducir(a, b), c) = reducir(a, reducir(b, c))
+//   reducir(identidad, a) = reducir(a, identidad) = a
+// -----------------------------------------------------------------------------
+typedef TElemento (*FReducir) (TElemento acumulado, TElemento e);
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Aplica map a todos los elementos usando hasta hilos hilos (contando
+//       el que llama). map puede ejecutarse a la vez sobre elementos
+//       distintos y en cualquier orden. Con hilos < 2 equivale a recorrer
+// -----------------------------------------------------------------------------
+void recorrer_paralelo (TLista lista, FMap map, int hilos);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve reducir(...reducir(reducir(identidad, e1), e2)..., en)
+//       calculado por tramos en paralelo y combinando los resultados de los
+//       tramos en el orden de la lista (no hace falta que sea conmutativa)
+//       reducir_paralelo(crear_lista_vacia, reducir, identidad, h) = identidad
+// -----------------------------------------------------------------------------
+TElemento reducir_paralelo (TLista lista, FReducir reducir, TElemento identidad, int hilos);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que ordenar_lista (estable, mismo resultado) usando hasta hilos
+//       hilos: la lista se parte en tramos que se ordenan a la vez y después
+//       se mezclan por parejas, también a la vez, hasta que queda uno
+//       Cada nivel de mezclas tiene la mitad de parejas que el anterior y la
+//       última mezcla, de las dos mitades de la lista, la hace un solo hilo:
+//       esa pasada O(n) no se reparte y limita la ganancia con muchos hilos
+//       Las listas cortas o con hilos < 2 se ordenan en un solo hilo
+// -----------------------------------------------------------------------------
+void ordenar_lista_paralelo (TLista* lista, FComparar comparar, int hilos);
+
+// -----------------------------------------------------------------------------
+// POST: Termina y espera a los hilos del pool (se vuelven a crear si se
+//       llama otra vez a una operación paralela)
+// -----------------------------------------------------------------------------
+void terminar_hilos_paralelos (void);
+
+#endif
@@ -0,0 +1,238 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "listas_persistentes.h"
+#include <stdlib.h>
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TListaPersistente crear_lista_persistente (void)
+{
+	return NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Anota un puntero más al nodo (si no es nulo) y lo devuelve
+// O(1)
+// -----------------------------------------------------------------------------
+TNodoPersistente* retener_nodo (TNodoPersistente* nodo)
+{
+	if (nodo != NULL)
+		atomic_fetch_add_explicit (&(nodo->referencias), 1, memory_order_relaxed);
+	return nodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita un uso del dato del nodo dueño; con el último destruye el dato
+//       y libera el nodo
+// O(1)
+// -----------------------------------------------------------------------------
+void soltar_dato (TNodoPersistente* duenno, FDestruir destruir)
+{
+	if (atomic_fetch_sub_explicit (&(duenno->usos), 1, memory_order_acq_rel) == 1)
+	{
+		destruir (duenno->dato);
+		free (duenno);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita un puntero al nodo. Si era el último, el nodo deja de estar en
+//       la lista: se suelta su siguiente (y así en cadena) y su dato
+// O(nodos liberados)
+// -----------------------------------------------------------------------------
+void soltar_nodo (TNodoPersistente* nodo, FDestruir destruir)
+{
+	TNodoPersistente* sig;
+	
+	while ((nodo != NULL) &&
+	       (atomic_fetch_sub_explicit (&(nodo->referencias), 1, memory_order_acq_rel) == 1))
+	{
+		sig = nodo->next;
+		
+		// Una copia se libera ya; el dueño espera a que no queden copias
+		if (nodo->origen != NULL)
+		{
+			soltar_dato (nodo->origen, destruir);
+			free (nodo);
+		}
+		else
+			soltar_dato (nodo, destruir);
+		
+		nodo = sig;
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea un nodo con e delante de sig (del que toma el puntero que ya
+//       tenía quien llama)
+// O(1)
+// -----------------------------------------------------------------------------
+TNodoPersistente* crear_nodo_persistente (TElemento e, TNodoPersistente* sig, TNodoPersistente* origen)
+{
+	TNodoPersistente* nodo;
+	nodo = (TNodoPersistente*)malloc(sizeof(TNodoPersistente));
+	
+	nodo->dato = e;
+	nodo->next = sig;
+	nodo->origen = origen;
+	atomic_init (&(nodo->referencias), 1);
+	atomic_init (&(nodo->usos), 1);
+	
+	return nodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+TListaPersistente instantanea (TListaPersistente lista)
+{
+	return retener_nodo (lista);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+void insertar_persistente (TListaPersistente* lista, TElemento e)
+{
+	*lista = crear_nodo_persistente (e, *lista, NULL);
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: *ptrptrnodo no es nulo y la versión es la única que llega a
+//      ptrptrnodo (es la propia variable de la lista o el next de un nodo
+//      con una sola referencia)
+// POST: Quita el primer nodo desde *ptrptrnodo que coincide con e, copiando
+//       los nodos compartidos que hay delante. Devuelve el enlace que
+//       apunta ahora al siguiente del nodo quitado (que cumple lo mismo que
+//       ptrptrnodo), o NULL si no hay coincidencias
+// O(n)
+// -----------------------------------------------------------------------------
+TNodoPersistente** quitar_persistente (TNodoPersistente** ptrptrnodo, TElemento e, FComparar comparar, FDestruir destruir)
+{
+	TNodoPersistente* ptrnodo;
+	TNodoPersistente* coincidencia;
+	TNodoPersistente* copia;
+	
+	for (coincidencia = *ptrptrnodo; coincidencia != NULL; coincidencia = coincidencia->next)
+	{
+		if (comparar (e, coincidencia->dato) == 0)
+			break;
+	}
+	if (coincidencia == NULL)
+		return NULL;
+	
+	ptrnodo = *ptrptrnodo;
+	while (ptrnodo != coincidencia)
+	{
+		// Un nodo que sólo ve esta versión se puede modificar: se avanza.
+		// Uno compartido se sustituye por una copia (y desde ahí todos los
+		// siguientes quedan compartidos con el original)
+		if (atomic_load_explicit (&(ptrnodo->referencias), memory_order_acquire) > 1)
+		{
+			copia = crear_nodo_persistente (ptrnodo->dato, retener_nodo (ptrnodo->next),
+			                                (ptrnodo->origen != NULL) ? ptrnodo->origen : ptrnodo);
+			atomic_fetch_add_explicit (&(copia->origen->usos), 1, memory_order_relaxed);
+			*ptrptrnodo = copia;
+			soltar_nodo (ptrnodo, destruir);
+			ptrnodo = copia;
+		}
+		ptrptrnodo = &(ptrnodo->next);
+		ptrnodo = ptrnodo->next;
+	}
+	
+	*ptrptrnodo = retener_nodo (coincidencia->next);
+	soltar_nodo (coincidencia, destruir);
+	return ptrptrnodo;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int borrar_persistente (TListaPersistente* lista, TElemento e, int todos, FComparar comparar, FDestruir destruir)
+{
+	TNodoPersistente** ptrptrnodo;
+	int n;
+	
+	n = 0;
+	ptrptrnodo = lista;
+	while ((ptrptrnodo != NULL) && (*ptrptrnodo != NULL))
+	{
+		ptrptrnodo = quitar_persistente (ptrptrnodo, e, comparar, destruir);
+		if (ptrptrnodo != NULL)
+			n++;
+		if (!todos)
+			break;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int buscar_persistente (TListaPersistente lista, TElemento e, FComparar comparar)
+{
+	TNodoPersistente* ptrnodo;
+	int n;
+	
+	n = 0;
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		if (comparar (e, ptrnodo->dato) == 0)
+			n++;
+	}
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void recorrer_persistente (TListaPersistente lista, FMap map)
+{
+	TNodoPersistente* ptrnodo;
+	
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		map (ptrnodo->dato);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(nodos liberados)
+// -----------------------------------------------------------------------------
+void liberar_persistente (TListaPersistente* lista, FDestruir destruir)
+{
+	soltar_nodo (*lista, destruir);
+	*lista = NULL;
+}
@@ -0,0 +1,104 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_PERSISTENTES_H
+#define LISTAS_PERSISTENTES_H
+
+#include <stdatomic.h>
+#include "listas.h"
+
+// -----------------------------------------------------------------------------
+// Listas persistentes
+//
+// Cada versión de la lista es un puntero a su primer nodo y las versiones
+// comparten los nodos comunes, que cuentan cuántos punteros les llegan.
+// Sacar una instantánea cuesta O(1) y la versión original puede seguir
+// modificándose sin que la instantánea cambie:
+//   - insertar_persistente añade un nodo delante y comparte el resto
+//   - borrar_persistente copia sólo los nodos compartidos que hay delante
+//     del borrado; los que sólo ve esa versión se modifican directamente
+// Un nodo se libera cuando ya no lo ve ninguna versión, y el elemento se
+// destruye cuando se libera el último nodo que lo contiene (una copia
+// comparte el elemento con el nodo original)
+//
+// Un hilo puede modificar una versión mientras otros leen o liberan
+// instantáneas suyas; una misma versión no debe modificarse desde dos hilos
+// -----------------------------------------------------------------------------
+
+typedef struct nodo_persistente
+{
+	TElemento                dato;
+	struct nodo_persistente* next;
+	_Atomic int              referencias;   // punteros que llegan al nodo
+	_Atomic int              usos;          // nodos vivos con este dato
+	struct nodo_persistente* origen;        // nodo dueño del dato si es copia
+} TNodoPersistente;
+
+typedef TNodoPersistente* TListaPersistente;
+
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve una lista persistente vacía
+// -----------------------------------------------------------------------------
+TListaPersistente crear_lista_persistente (void);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve una versión de la lista que no cambiará aunque cambie lista
+//       Se libera con liberar_persistente
+// O(1)
+// -----------------------------------------------------------------------------
+TListaPersistente instantanea (TListaPersistente lista);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que insertar_elemento, las instantáneas anteriores no cambian
+// O(1)
+// -----------------------------------------------------------------------------
+void insertar_persistente (TListaPersistente* lista, TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que borrar_elemento, las instantáneas anteriores no cambian
+//       destruir se llama con los elementos que ya no ve ninguna versión
+//       Devuelve el número de elementos quitados de lista
+// O(n)
+// -----------------------------------------------------------------------------
+int borrar_persistente (TListaPersistente* lista, TElemento e, int todos, FComparar comparar, FDestruir destruir);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que buscar_elemento
+// -----------------------------------------------------------------------------
+int buscar_persistente (TListaPersistente lista, TElemento e, FComparar comparar);
+
+// -----------------------------------------------------------------------------
+// POST: Igual que recorrer
+// -----------------------------------------------------------------------------
+void recorrer_persistente (TListaPersistente lista, FMap map);
+
+// -----------------------------------------------------------------------------
+// POST: Suelta la versión (*lista queda vacía). Se liberan los nodos que ya
+//       no ve ninguna versión y se destruyen sus elementos con destruir
+// O(nodos liberados)
+// -----------------------------------------------------------------------------
+void liberar_persistente (TListaPersistente* lista, FDestruir destruir);
+
+#endif
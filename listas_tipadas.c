@@ -0,0 +1,473 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+// Genera también las funciones de cada tipo de lista
+#define LT_IMPLEMENTAR
+#include "listas_tipadas.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+// -----------------------------------------------------------------------------
+// Vectores de int
+// Las comparaciones vectoriales dejan -1 (todos los bits a 1) en las
+// posiciones que cumplen y 0 en las demás
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int contar_vector_int (const int* v, int n, int x)
+{
+	int i, j, c;
+
+	i = 0;
+	c = 0;
+#if defined(__AVX2__)
+	int parcial[8];
+	__m256i vx = _mm256_set1_epi32(x);
+	__m256i acc = _mm256_setzero_si256();
+	for (; i + 8 <= n; i += 8)
+		acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(v + i)), vx));
+	_mm256_storeu_si256((__m256i*)parcial, acc);
+	for (j = 0; j < 8; j++)
+		c += parcial[j];
+#elif defined(__SSE2__)
+	int parcial[4];
+	__m128i vx = _mm_set1_epi32(x);
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 4 <= n; i += 4)
+		acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i)), vx));
+	_mm_storeu_si128((__m128i*)parcial, acc);
+	for (j = 0; j < 4; j++)
+		c += parcial[j];
+#endif
+	for (j = i; j < n; j++)
+		c += (v[j] == x);
+	return c;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n), termina en la primera coincidencia
+// -----------------------------------------------------------------------------
+int posicion_vector_int (const int* v, int n, int x)
+{
+	int i;
+
+	i = 0;
+#if defined(__AVX2__)
+	int mascara;
+	__m256i vx = _mm256_set1_epi32(x);
+	for (; i + 8 <= n; i += 8)
+	{
+		mascara = _mm256_movemask_ps(_mm256_castsi256_ps(
+			_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(v + i)), vx)));
+		if (mascara != 0)
+			return i + __builtin_ctz(mascara);
+	}
+#elif defined(__SSE2__)
+	int mascara;
+	__m128i vx = _mm_set1_epi32(x);
+	for (; i + 4 <= n; i += 4)
+	{
+		mascara = _mm_movemask_ps(_mm_castsi128_ps(
+			_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i)), vx)));
+		if (mascara != 0)
+			return i + __builtin_ctz(mascara);
+	}
+#endif
+	for (; i < n; i++)
+	{
+		if (v[i] == x)
+			return i;
+	}
+	return -1;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: n > 0
+// POST: Devuelve el menor (signo = 1) o el mayor (signo = -1) de v
+// O(n)
+// -----------------------------------------------------------------------------
+int extremo_vector_int (const int* v, int n, int signo)
+{
+	int i, j, m;
+
+	i = 0;
+	m = v[0];
+#if defined(__AVX2__)
+	int parcial[8];
+	if (n >= 8)
+	{
+		__m256i acc = _mm256_loadu_si256((const __m256i*)v);
+		for (i = 8; i + 8 <= n; i += 8)
+		{
+			if (signo > 0)
+				acc = _mm256_min_epi32(acc, _mm256_loadu_si256((const __m256i*)(v + i)));
+			else
+				acc = _mm256_max_epi32(acc, _mm256_loadu_si256((const __m256i*)(v + i)));
+		}
+		_mm256_storeu_si256((__m256i*)parcial, acc);
+		for (j = 0; j < 8; j++)
+		{
+			if (signo > 0 ? parcial[j] < m : parcial[j] > m)
+				m = parcial[j];
+		}
+	}
+#elif defined(__SSE2__)
+	int parcial[4];
+	if (n >= 4)
+	{
+		// SSE2 no tiene min_epi32 ni max_epi32: se elige con la máscara de cmpgt
+		__m128i acc = _mm_loadu_si128((const __m128i*)v);
+		__m128i b, cambiar;
+		for (i = 4; i + 4 <= n; i += 4)
+		{
+			b = _mm_loadu_si128((const __m128i*)(v + i));
+			cambiar = (signo > 0) ? _mm_cmpgt_epi32(acc, b) : _mm_cmpgt_epi32(b, acc);
+			acc = _mm_or_si128(_mm_and_si128(cambiar, b), _mm_andnot_si128(cambiar, acc));
+		}
+		_mm_storeu_si128((__m128i*)parcial, acc);
+		for (j = 0; j < 4; j++)
+		{
+			if (signo > 0 ? parcial[j] < m : parcial[j] > m)
+				m = parcial[j];
+		}
+	}
+#endif
+	for (j = i; j < n; j++)
+	{
+		if (signo > 0 ? v[j] < m : v[j] > m)
+			m = v[j];
+	}
+	return m;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int minimo_vector_int (const int* v, int n)
+{
+	return extremo_vector_int (v, n, 1);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int maximo_vector_int (const int* v, int n)
+{
+	return extremo_vector_int (v, n, -1);
+}
+
+
+// -----------------------------------------------------------------------------
+// Vectores de int64_t
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int contar_vector_int64 (const int64_t* v, int n, int64_t x)
+{
+	int i, j, c;
+
+	i = 0;
+	c = 0;
+#if defined(__AVX2__)
+	int64_t parcial[4];
+	__m256i vx = _mm256_set1_epi64x(x);
+	__m256i acc = _mm256_setzero_si256();
+	for (; i + 4 <= n; i += 4)
+		acc = _mm256_sub_epi64(acc, _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(v + i)), vx));
+	_mm256_storeu_si256((__m256i*)parcial, acc);
+	for (j = 0; j < 4; j++)
+		c += (int)parcial[j];
+#elif defined(__SSE2__)
+	// SSE2 no compara enteros de 64 bits: son iguales si lo son sus dos mitades
+	__m128i vx = _mm_set1_epi64x(x);
+	__m128i eq;
+	for (; i + 2 <= n; i += 2)
+	{
+		eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i)), vx);
+		eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+		c += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(eq)));
+	}
+#endif
+	for (j = i; j < n; j++)
+		c += (v[j] == x);
+	return c;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n), termina en la primera coincidencia
+// -----------------------------------------------------------------------------
+int posicion_vector_int64 (const int64_t* v, int n, int64_t x)
+{
+	int i;
+
+	i = 0;
+#if defined(__AVX2__)
+	int mascara;
+	__m256i vx = _mm256_set1_epi64x(x);
+	for (; i + 4 <= n; i += 4)
+	{
+		mascara = _mm256_movemask_pd(_mm256_castsi256_pd(
+			_mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(v + i)), vx)));
+		if (mascara != 0)
+			return i + __builtin_ctz(mascara);
+	}
+#elif defined(__SSE2__)
+	int mascara;
+	__m128i vx = _mm_set1_epi64x(x);
+	__m128i eq;
+	for (; i + 2 <= n; i += 2)
+	{
+		eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(v + i)), vx);
+		eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+		mascara = _mm_movemask_pd(_mm_castsi128_pd(eq));
+		if (mascara != 0)
+			return i + __builtin_ctz(mascara);
+	}
+#endif
+	for (; i < n; i++)
+	{
+		if (v[i] == x)
+			return i;
+	}
+	return -1;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: n > 0
+// POST: Devuelve el menor (signo = 1) o el mayor (signo = -1) de v
+//       SSE2 no compara enteros de 64 bits con signo, sólo AVX2 vectoriza
+// O(n)
+// -----------------------------------------------------------------------------
+int64_t extremo_vector_int64 (const int64_t* v, int n, int signo)
+{
+	int i, j;
+	int64_t m;
+
+	i = 0;
+	m = v[0];
+#if defined(__AVX2__)
+	int64_t parcial[4];
+	if (n >= 4)
+	{
+		__m256i acc = _mm256_loadu_si256((const __m256i*)v);
+		__m256i b, cambiar;
+		for (i = 4; i + 4 <= n; i += 4)
+		{
+			b = _mm256_loadu_si256((const __m256i*)(v + i));
+			cambiar = (signo > 0) ? _mm256_cmpgt_epi64(acc, b) : _mm256_cmpgt_epi64(b, acc);
+			acc = _mm256_blendv_epi8(acc, b, cambiar);
+		}
+		_mm256_storeu_si256((__m256i*)parcial, acc);
+		for (j = 0; j < 4; j++)
+		{
+			if (signo > 0 ? parcial[j] < m : parcial[j] > m)
+				m = parcial[j];
+		}
+	}
+#endif
+	for (j = i; j < n; j++)
+	{
+		if (signo > 0 ? v[j] < m : v[j] > m)
+			m = v[j];
+	}
+	return m;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int64_t minimo_vector_int64 (const int64_t* v, int n)
+{
+	return extremo_vector_int64 (v, n, 1);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int64_t maximo_vector_int64 (const int64_t* v, int n)
+{
+	return extremo_vector_int64 (v, n, -1);
+}
+
+
+// -----------------------------------------------------------------------------
+// Vectores de double
+// Con NaN en el vector el mínimo y el máximo no están definidos
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int contar_vector_double (const double* v, int n, double x)
+{
+	int i, c;
+
+	i = 0;
+	c = 0;
+#if defined(__AVX2__)
+	__m256d vx = _mm256_set1_pd(x);
+	for (; i + 4 <= n; i += 4)
+		c += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(v + i), vx, _CMP_EQ_OQ)));
+#elif defined(__SSE2__)
+	__m128d vx = _mm_set1_pd(x);
+	for (; i + 2 <= n; i += 2)
+		c += __builtin_popcount(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(v + i), vx)));
+#endif
+	for (; i < n; i++)
+		c += (v[i] == x);
+	return c;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n), termina en la primera coincidencia
+// -----------------------------------------------------------------------------
+int posicion_vector_double (const double* v, int n, double x)
+{
+	int i;
+
+	i = 0;
+#if defined(__AVX2__)
+	int mascara;
+	__m256d vx = _mm256_set1_pd(x);
+	for (; i + 4 <= n; i += 4)
+	{
+		mascara = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(v + i), vx, _CMP_EQ_OQ));
+		if (mascara != 0)
+			return i + __builtin_ctz(mascara);
+	}
+#elif defined(__SSE2__)
+	int mascara;
+	__m128d vx = _mm_set1_pd(x);
+	for (; i + 2 <= n; i += 2)
+	{
+		mascara = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(v + i), vx));
+		if (mascara != 0)
+			return i + __builtin_ctz(mascara);
+	}
+#endif
+	for (; i < n; i++)
+	{
+		if (v[i] == x)
+			return i;
+	}
+	return -1;
+}
+
+
+// -----------------------------------------------------------------------------
+// PRE: n > 0
+// POST: Devuelve el menor (signo = 1) o el mayor (signo = -1) de v
+// O(n)
+// -----------------------------------------------------------------------------
+double extremo_vector_double (const double* v, int n, int signo)
+{
+	int i, j;
+	double m;
+
+	i = 0;
+	m = v[0];
+#if defined(__AVX2__)
+	double parcial[4];
+	if (n >= 4)
+	{
+		__m256d acc = _mm256_loadu_pd(v);
+		for (i = 4; i + 4 <= n; i += 4)
+		{
+			if (signo > 0)
+				acc = _mm256_min_pd(acc, _mm256_loadu_pd(v + i));
+			else
+				acc = _mm256_max_pd(acc, _mm256_loadu_pd(v + i));
+		}
+		_mm256_storeu_pd(parcial, acc);
+		for (j = 0; j < 4; j++)
+		{
+			if (signo > 0 ? parcial[j] < m : parcial[j] > m)
+				m = parcial[j];
+		}
+	}
+#elif defined(__SSE2__)
+	double parcial[2];
+	if (n >= 2)
+	{
+		__m128d acc = _mm_loadu_pd(v);
+		for (i = 2; i + 2 <= n; i += 2)
+		{
+			if (signo > 0)
+				acc = _mm_min_pd(acc, _mm_loadu_pd(v + i));
+			else
+				acc = _mm_max_pd(acc, _mm_loadu_pd(v + i));
+		}
+		_mm_storeu_pd(parcial, acc);
+		for (j = 0; j < 2; j++)
+		{
+			if (signo > 0 ? parcial[j] < m : parcial[j] > m)
+				m = parcial[j];
+		}
+	}
+#endif
+	for (j = i; j < n; j++)
+	{
+		if (signo > 0 ? v[j] < m : v[j] > m)
+			m = v[j];
+	}
+	return m;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+double minimo_vector_double (const double* v, int n)
+{
+	return extremo_vector_double (v, n, 1);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+double maximo_vector_double (const double* v, int n)
+{
+	return extremo_vector_double (v, n, -1);
+}
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef LISTAS_TIPADAS_H
+#define LISTAS_TIPADAS_H
+
+#include <stdint.h>
+#include <math.h>
+
+// -----------------------------------------------------------------------------
+// Listas de valores: guardan int, int64_t o double directamente en nodos de
+// BYTES_POR_NODO_TIPADO bytes, sin reservar cada elemento aparte y sin función
+// de comparación. Buscar, contar y calcular mínimo y máximo recorren cada nodo
+// con las funciones *_vector, que usan AVX2 o SSE2 si el compilador las
+// habilita (-mavx2, -msse2) y un bucle normal en otro caso
+//
+// Cada tipo se genera a partir de listas_tipadas_plantilla.h con:
+//   TLista<Nombre>, TNodo<Nombre>, FMap<Nombre> y las operaciones
+//   crear_lista_vacia_<s>, es_lista_vacia_<s>, insertar_elemento_<s>,
+//   buscar_elemento_<s>, posicion_elemento_<s>, minimo_<s>, maximo_<s>,
+//   recorrer_<s>, borrar_elemento_<s>, ordenar_lista_<s>, destruir_lista_<s>
+// Tipos generados: Int (s = int), Int64 (s = int64) y Double (s = double)
+// -----------------------------------------------------------------------------
+#define BYTES_POR_NODO_TIPADO 256
+
+
+// -----------------------------------------------------------------------------
+// Funciones sobre vectores de n elementos
+// contar_vector_*:   devuelve cuántos elementos son iguales a x
+// posicion_vector_*: devuelve el índice del primero igual a x o -1
+// minimo_vector_*, maximo_vector_*: PRE n > 0
+// -----------------------------------------------------------------------------
+int     contar_vector_int (const int* v, int n, int x);
+int     posicion_vector_int (const int* v, int n, int x);
+int     minimo_vector_int (const int* v, int n);
+int     maximo_vector_int (const int* v, int n);
+
+int     contar_vector_int64 (const int64_t* v, int n, int64_t x);
+int     posicion_vector_int64 (const int64_t* v, int n, int64_t x);
+int64_t minimo_vector_int64 (const int64_t* v, int n);
+int64_t maximo_vector_int64 (const int64_t* v, int n);
+
+int     contar_vector_double (const double* v, int n, double x);
+int     posicion_vector_double (const double* v, int n, double x);
+double  minimo_vector_double (const double* v, int n);
+double  maximo_vector_double (const double* v, int n);
+
+
+// Construcción de nombres dentro de la plantilla
+#define LT_CONCAT_(a, b) a##b
+#define LT_CONCAT(a, b) LT_CONCAT_(a, b)
+#define LT(nombre) LT_CONCAT(nombre, LT_SUFIJO)
+
+#define LT_TIPO int
+#define LT_NOMBRE Int
+#define LT_SUFIJO _int
+#include "listas_tipadas_plantilla.h"
+
+#define LT_TIPO int64_t
+#define LT_NOMBRE Int64
+#define LT_SUFIJO _int64
+#include "listas_tipadas_plantilla.h"
+
+#define LT_TIPO double
+#define LT_NOMBRE Double
+#define LT_SUFIJO _double
+#define LT_ES_NAN(x) isnan(x)
+#include "listas_tipadas_plantilla.h"
+
+#endif
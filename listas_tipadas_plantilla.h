@@ -0,0 +1,427 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// -----------------------------------------------------------------------------
+// Plantilla de lista de valores (se incluye una vez por tipo desde
+// listas_tipadas.h, sin guarda de inclusión)
+// PRE: LT_TIPO, LT_NOMBRE y LT_SUFIJO definidos
+//      Con LT_IMPLEMENTAR definido genera también las funciones
+//      LT_ES_NAN(x), opcional, dice si un valor no es comparable (NaN); por
+//      defecto ninguno lo es
+// -----------------------------------------------------------------------------
+
+#ifndef LT_ES_NAN
+#define LT_ES_NAN(x) 0
+#endif
+
+#define LT_NODO LT_CONCAT(TNodo, LT_NOMBRE)
+#define LT_LISTA LT_CONCAT(TLista, LT_NOMBRE)
+#define LT_FMAP LT_CONCAT(FMap, LT_NOMBRE)
+#define LT_CAPACIDAD ((int)((BYTES_POR_NODO_TIPADO - sizeof(void*) - sizeof(int)) / sizeof(LT_TIPO)))
+
+// Los valores ocupan el final del vector: datos[LT_CAPACIDAD-n .. LT_CAPACIDAD-1]
+// así insertar por la cabeza no desplaza nada. El vector llena lo que dejan
+// next y n hasta BYTES_POR_NODO_TIPADO
+typedef struct LT(nodo)
+{
+	struct LT(nodo)* next;
+	int              n;
+	LT_TIPO          datos[LT_CAPACIDAD];
+} LT_NODO;
+
+_Static_assert (sizeof(LT_NODO) <= BYTES_POR_NODO_TIPADO, "el nodo tipado no cabe en BYTES_POR_NODO_TIPADO");
+
+typedef LT_NODO* LT_LISTA;
+
+typedef void (*LT_FMAP) (LT_TIPO e);
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea y devuelve una lista vacía
+// -----------------------------------------------------------------------------
+LT_LISTA LT(crear_lista_vacia) (void);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve distinto de cero si la lista no contiene elementos
+// -----------------------------------------------------------------------------
+int LT(es_lista_vacia) (LT_LISTA lista);
+
+// -----------------------------------------------------------------------------
+// POST: Inserta un valor en la lista (por la cabeza)
+// -----------------------------------------------------------------------------
+void LT(insertar_elemento) (LT_LISTA* lista, LT_TIPO e);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el número de valores iguales a e
+// -----------------------------------------------------------------------------
+int LT(buscar_elemento) (LT_LISTA lista, LT_TIPO e);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la posición (desde 0) del primer valor igual a e o -1 si no
+//       está. Termina en cuanto lo encuentra
+// -----------------------------------------------------------------------------
+int LT(posicion_elemento) (LT_LISTA lista, LT_TIPO e);
+
+// -----------------------------------------------------------------------------
+// POST: Deja en *res el menor (mayor) valor de la lista y devuelve distinto de
+//       cero, o devuelve 0 si la lista está vacía
+// -----------------------------------------------------------------------------
+int LT(minimo) (LT_LISTA lista, LT_TIPO* res);
+int LT(maximo) (LT_LISTA lista, LT_TIPO* res);
+
+// -----------------------------------------------------------------------------
+// POST: Recorre la lista aplicando la función map a cada valor
+// -----------------------------------------------------------------------------
+void LT(recorrer) (LT_LISTA lista, LT_FMAP map);
+
+// -----------------------------------------------------------------------------
+// POST: Si todos==0 borra el primer valor igual a e, si no borra todos
+//       Fusiona nodos consecutivos cuando uno queda por debajo de la mitad
+// -----------------------------------------------------------------------------
+void LT(borrar_elemento) (LT_LISTA* lista, LT_TIPO e, int todos);
+
+// -----------------------------------------------------------------------------
+// POST: Ordena la lista de menor a mayor. Sólo el primer nodo puede quedar
+//       sin llenar
+//       Los NaN quedan al final. No es estable: los valores que se comparan
+//       iguales pero no son idénticos (-0.0 y 0.0) quedan en cualquier orden
+// -----------------------------------------------------------------------------
+void LT(ordenar_lista) (LT_LISTA* lista);
+
+// -----------------------------------------------------------------------------
+// POST: Libera la memoria dinámica utilizada por la lista
+// -----------------------------------------------------------------------------
+void LT(destruir_lista) (LT_LISTA* lista);
+
+
+#ifdef LT_IMPLEMENTAR
+
+// Primer valor ocupado del nodo
+#define LT_INICIO(ptrnodo) (&((ptrnodo)->datos[LT_CAPACIDAD - (ptrnodo)->n]))
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+LT_LISTA LT(crear_lista_vacia) (void)
+{
+	return NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+int LT(es_lista_vacia) (LT_LISTA lista)
+{
+	return lista == NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(1)
+// -----------------------------------------------------------------------------
+void LT(insertar_elemento) (LT_LISTA* ptrlista, LT_TIPO e)
+{
+	LT_NODO* ptrnodo;
+	
+	ptrnodo = *ptrlista;
+	if ((ptrnodo == NULL) || (ptrnodo->n == LT_CAPACIDAD))
+	{
+		ptrnodo = (LT_NODO*)malloc(sizeof(LT_NODO));
+		ptrnodo->n = 0;
+		ptrnodo->next = *ptrlista;
+		*ptrlista = ptrnodo;
+	}
+	
+	ptrnodo->n++;
+	*LT_INICIO(ptrnodo) = e;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int LT(buscar_elemento) (LT_LISTA lista, LT_TIPO e)
+{
+	LT_NODO* ptrnodo;
+	int n;
+	
+	n = 0;
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		n += LT(contar_vector) (LT_INICIO(ptrnodo), ptrnodo->n, e);
+	
+	return n;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int LT(posicion_elemento) (LT_LISTA lista, LT_TIPO e)
+{
+	LT_NODO* ptrnodo;
+	int base, i;
+	
+	base = 0;
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		i = LT(posicion_vector) (LT_INICIO(ptrnodo), ptrnodo->n, e);
+		if (i >= 0)
+			return base + i;
+		base += ptrnodo->n;
+	}
+	return -1;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int LT(minimo) (LT_LISTA lista, LT_TIPO* res)
+{
+	LT_NODO* ptrnodo;
+	LT_TIPO m;
+	
+	if (lista == NULL)
+		return 0;
+	
+	*res = LT(minimo_vector) (LT_INICIO(lista), lista->n);
+	for (ptrnodo = lista->next; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		m = LT(minimo_vector) (LT_INICIO(ptrnodo), ptrnodo->n);
+		if (m < *res)
+			*res = m;
+	}
+	return 1;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+int LT(maximo) (LT_LISTA lista, LT_TIPO* res)
+{
+	LT_NODO* ptrnodo;
+	LT_TIPO m;
+	
+	if (lista == NULL)
+		return 0;
+	
+	*res = LT(maximo_vector) (LT_INICIO(lista), lista->n);
+	for (ptrnodo = lista->next; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		m = LT(maximo_vector) (LT_INICIO(ptrnodo), ptrnodo->n);
+		if (m > *res)
+			*res = m;
+	}
+	return 1;
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void LT(recorrer) (LT_LISTA lista, LT_FMAP map)
+{
+	LT_NODO* ptrnodo;
+	int i;
+	
+	for (ptrnodo = lista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		for (i = LT_CAPACIDAD - ptrnodo->n; i < LT_CAPACIDAD; i++)
+			map (ptrnodo->datos[i]);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n)
+// -----------------------------------------------------------------------------
+void LT(borrar_elemento) (LT_LISTA* ptrlista, LT_TIPO e, int todos)
+{
+	LT_NODO** ptrptrnodo;
+	LT_NODO* ptrnodo;
+	LT_NODO* ant;
+	int i, j;
+	int borrado;    // ya se borró el único valor pedido
+	int tras;       // nodos revisados después del borrado
+	
+	ant = NULL;
+	borrado = 0;
+	tras = 0;
+	ptrptrnodo = ptrlista;
+	while (*ptrptrnodo != NULL)
+	{
+		// Tras el borrado sólo falta revisar si el nodo siguiente se fusiona
+		if (borrado && (++tras > 1))
+			break;
+		
+		ptrnodo = *ptrptrnodo;
+		if (!borrado && !todos)
+		{
+			i = LT(posicion_vector) (LT_INICIO(ptrnodo), ptrnodo->n, e);
+			if (i >= 0)
+			{
+				// Desplaza una posición los valores anteriores al borrado
+				memmove (LT_INICIO(ptrnodo) + 1, LT_INICIO(ptrnodo), i * sizeof(LT_TIPO));
+				ptrnodo->n--;
+				borrado = 1;
+			}
+		}
+		else if (todos && (LT(contar_vector) (LT_INICIO(ptrnodo), ptrnodo->n, e) > 0))
+		{
+			// Compacta hacia el final conservando el orden
+			j = LT_CAPACIDAD - 1;
+			for (i = LT_CAPACIDAD - 1; i >= LT_CAPACIDAD - ptrnodo->n; i--)
+			{
+				if (ptrnodo->datos[i] != e)
+					ptrnodo->datos[j--] = ptrnodo->datos[i];
+			}
+			ptrnodo->n = LT_CAPACIDAD - 1 - j;
+		}
+		
+		if (ptrnodo->n == 0)
+		{
+			*ptrptrnodo = ptrnodo->next;
+			free (ptrnodo);
+			continue;
+		}
+		
+		// Fusiona con el anterior si alguno está por debajo de la mitad y caben
+		if ((ant != NULL) && (ant->n + ptrnodo->n <= LT_CAPACIDAD) &&
+		    ((ant->n < LT_CAPACIDAD / 2) || (ptrnodo->n < LT_CAPACIDAD / 2)))
+		{
+			memmove (LT_INICIO(ant) - ptrnodo->n, LT_INICIO(ant), ant->n * sizeof(LT_TIPO));
+			memcpy (&(ant->datos[LT_CAPACIDAD - ptrnodo->n]), LT_INICIO(ptrnodo), ptrnodo->n * sizeof(LT_TIPO));
+			ant->n += ptrnodo->n;
+			*ptrptrnodo = ptrnodo->next;
+			free (ptrnodo);
+			continue;
+		}
+		
+		ant = ptrnodo;
+		ptrptrnodo = &(ptrnodo->next);
+	}
+}
+
+
+// -----------------------------------------------------------------------------
+// POST: Función de comparación para qsort. Los NaN van detrás de todos los
+//       demás valores y son iguales entre sí, así el orden es total
+// -----------------------------------------------------------------------------
+int LT(comparar_valores) (const void* a, const void* b)
+{
+	LT_TIPO e1 = *((const LT_TIPO*)a);
+	LT_TIPO e2 = *((const LT_TIPO*)b);
+	
+	if (LT_ES_NAN(e1) || LT_ES_NAN(e2))
+		return LT_ES_NAN(e1) - LT_ES_NAN(e2);
+	return (e1 > e2) - (e1 < e2);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n log n)
+// -----------------------------------------------------------------------------
+void LT(ordenar_lista) (LT_LISTA* ptrlista)
+{
+	LT_NODO* ptrnodo;
+	LT_NODO* sobrante;
+	LT_TIPO* v;
+	int n, k, c;
+	
+	n = 0;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+		n += ptrnodo->n;
+	
+	if (n < 2)
+		return;
+	
+	v = (LT_TIPO*)malloc(n * sizeof(LT_TIPO));
+	k = 0;
+	for (ptrnodo = *ptrlista; ptrnodo != NULL; ptrnodo = ptrnodo->next)
+	{
+		memcpy (&(v[k]), LT_INICIO(ptrnodo), ptrnodo->n * sizeof(LT_TIPO));
+		k += ptrnodo->n;
+	}
+	
+	// qsort no es estable: sólo pueden cambiar de orden -0.0 y 0.0 entre sí
+	qsort (v, n, sizeof(LT_TIPO), LT(comparar_valores));
+	
+	// El primer nodo se queda con el resto para que los siguientes vayan llenos
+	k = 0;
+	c = n % LT_CAPACIDAD;
+	if (c == 0)
+		c = LT_CAPACIDAD;
+	ptrnodo = *ptrlista;
+	while (1)
+	{
+		ptrnodo->n = c;
+		memcpy (LT_INICIO(ptrnodo), &(v[k]), c * sizeof(LT_TIPO));
+		k += c;
+		if (k == n)
+			break;
+		c = LT_CAPACIDAD;
+		ptrnodo = ptrnodo->next;
+	}
+	
+	sobrante = ptrnodo->next;
+	ptrnodo->next = NULL;
+	while (sobrante != NULL)
+	{
+		ptrnodo = sobrante;
+		sobrante = sobrante->next;
+		free (ptrnodo);
+	}
+	
+	free (v);
+}
+
+
+// -----------------------------------------------------------------------------
+// O(n / LT_CAPACIDAD)
+// -----------------------------------------------------------------------------
+void LT(destruir_lista) (LT_LISTA* ptrlista)
+{
+	LT_NODO* ptrnodo;
+	
+	while (*ptrlista != NULL)
+	{
+		ptrnodo = *ptrlista;
+		*ptrlista = ptrnodo->next;
+		free (ptrnodo);
+	}
+}
+
+#undef LT_INICIO
+
+#endif
+
+#undef LT_NODO
+#undef LT_LISTA
+#undef LT_FMAP
+#undef LT_CAPACIDAD
+#undef LT_TIPO
+#undef LT_NOMBRE
+#undef LT_SUFIJO
+#undef LT_ES_NAN
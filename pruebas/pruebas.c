@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pruebas.h"
+
+
+// Prueba de un módulo
+typedef struct prueba
+{
+	const char* nombre;
+	void (*probar) (void);
+} TPrueba;
+
+const TPrueba pruebas[] =
+{
+	{ "cabecera", probar_cabecera },
+	{ "conjuntos", probar_conjuntos },
+	{ "enlaces", probar_enlaces },
+	{ "fichero", probar_fichero },
+	{ "persistentes", probar_persistentes },
+	{ "concurrentes", probar_concurrentes },
+	{ "paralelas", probar_paralelas }
+};
+
+#define NUM_PRUEBAS ((int)(sizeof(pruebas) / sizeof(pruebas[0])))
+
+int fallos = 0;
+int elementos_vivos = 0;
+
+
+
+// -----------------------------------------------------------------------------
+// Elementos de las pruebas: enteros reservados con malloc, como los de test.c,
+// para que se note si una operación destruye de más o de menos
+// -----------------------------------------------------------------------------
+TElemento crear_entero (int v)
+{
+	int* ptrint;
+	ptrint = malloc (sizeof(int));
+	*ptrint = v;
+	elementos_vivos++;
+	return ptrint;
+}
+
+int valor (TElemento e)
+{
+	return *((int*)e);
+}
+
+int comparar_enteros (TElemento e1, TElemento e2)
+{
+	int v1 = valor (e1);
+	int v2 = valor (e2);
+
+	return (v1 > v2) - (v1 < v2);
+}
+
+unsigned int hash_entero (TElemento e)
+{
+	return (unsigned int)valor (e) * 2654435761u;
+}
+
+void destruir_entero (TElemento e)
+{
+	elementos_vivos--;
+	free (e);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Generador congruencial: la misma semilla da siempre la misma secuencia
+// -----------------------------------------------------------------------------
+int aleatorio (unsigned int* semilla, int n)
+{
+	*semilla = *semilla * 1103515245u + 12345u;
+	return (int)((*semilla >> 16) % (unsigned int)n);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Listas a partir de vectores y comparación con vectores
+// -----------------------------------------------------------------------------
+TLista lista_de_enteros (const int* v, int n)
+{
+	int c;
+	TLista lista;
+
+	lista = crear_lista_vacia ();
+	for (c=n-1; c>=0; c--)
+		insertar_elemento (&lista, crear_entero (v[c]));
+	return lista;
+}
+
+int lista_igual (TLista lista, const int* v, int n)
+{
+	int c;
+
+	for (c=0; c<n; c++, lista=lista->next)
+		if (lista == NULL || valor (lista->dato) != v[c])
+			return 0;
+	return (lista == NULL);
+}
+
+int numero_nodos (TLista lista)
+{
+	int n = 0;
+
+	for (; lista != NULL; lista=lista->next)
+		n++;
+	return n;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Ejecuta todas las pruebas y termina con error si alguna falla
+// -----------------------------------------------------------------------------
+int main (void)
+{
+	int c, antes;
+
+	for (c=0; c<NUM_PRUEBAS; c++)
+	{
+		antes = fallos;
+		pruebas[c].probar ();
+		COMPROBAR (elementos_vivos == 0);
+		elementos_vivos = 0;
+		printf ("%-14s %s\n", pruebas[c].nombre, (fallos == antes) ? "ok" : "FALLA");
+	}
+
+	if (fallos != 0)
+	{
+		printf ("%d comprobaciones fallidas\n", fallos);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef PRUEBAS_H
+#define PRUEBAS_H
+
+#include <stdio.h>
+#include "listas.h"
+
+
+// -----------------------------------------------------------------------------
+// Pruebas de las listas (make check)
+// Cada probar_* comprueba un módulo con COMPROBAR; las que usan números al azar
+// parten de una semilla fija para que cada ejecución haga lo mismo
+// Los elementos son enteros reservados con crear_entero: al acabar cada prueba
+// no debe quedar ninguno vivo
+// -----------------------------------------------------------------------------
+
+// Comprobaciones fallidas en la ejecución
+extern int fallos;
+
+// Elementos creados con crear_entero y aún no destruidos
+extern int elementos_vivos;
+
+#define COMPROBAR(condicion) \
+	do { \
+		if (!(condicion)) \
+		{ \
+			fprintf (stderr, "%s:%d: falla %s\n", __FILE__, __LINE__, #condicion); \
+			fallos++; \
+		} \
+	} while (0)
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve un elemento nuevo con el valor v
+// -----------------------------------------------------------------------------
+TElemento crear_entero (int v);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el valor del elemento
+// -----------------------------------------------------------------------------
+int valor (TElemento e);
+
+// -----------------------------------------------------------------------------
+// FComparar, FHash y FDestruir para los elementos de crear_entero
+// -----------------------------------------------------------------------------
+int comparar_enteros (TElemento e1, TElemento e2);
+unsigned int hash_entero (TElemento e);
+void destruir_entero (TElemento e);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve un número pseudoaleatorio en [0, n) y avanza *semilla
+// -----------------------------------------------------------------------------
+int aleatorio (unsigned int* semilla, int n);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la lista [v[0], ..., v[n-1]] con elementos nuevos
+// -----------------------------------------------------------------------------
+TLista lista_de_enteros (const int* v, int n);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve 1 si la lista es [v[0], ..., v[n-1]], 0 si no
+// -----------------------------------------------------------------------------
+int lista_igual (TLista lista, const int* v, int n);
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el número de nodos de la lista
+// -----------------------------------------------------------------------------
+int numero_nodos (TLista lista);
+
+// -----------------------------------------------------------------------------
+// Pruebas de cada módulo
+// -----------------------------------------------------------------------------
+void probar_cabecera (void);
+void probar_conjuntos (void);
+void probar_enlaces (void);
+void probar_fichero (void);
+void probar_persistentes (void);
+void probar_concurrentes (void);
+void probar_paralelas (void);
+
+#endif
@@ -0,0 +1,229 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "pruebas.h"
+
+
+#define CABECERA_OPERACIONES 4000
+#define CABECERA_VALORES 40
+#define CABECERA_LOTE 4
+#define CABECERA_MAXIMO (CABECERA_OPERACIONES * CABECERA_LOTE)
+
+// Variantes de la cabecera que se prueban con las mismas operaciones
+enum VARIANTES_CABECERA { SIN_INDICE, CON_INDICE, INDICE_A_MITAD, POOL_E_INDICE, NUM_VARIANTES };
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Comprueba que cola y longitud corresponden a los nodos de la lista y
+//       que la lista es ref[0..n-1]. Con contar != 0 comprueba también que
+//       buscar_elemento_cab, con índice o sin él, cuenta lo mismo que ref
+// -----------------------------------------------------------------------------
+void comprobar_cabecera (TCabecera* cab, const int* ref, int n, int contar)
+{
+	int v, c, cuenta;
+	TNodoLista* ultimo;
+	TElemento e;
+
+	ultimo = NULL;
+	for (TNodoLista* nodo=cab->cabeza; nodo!=NULL; nodo=nodo->next)
+		ultimo = nodo;
+
+	COMPROBAR (longitud (cab) == n);
+	COMPROBAR (numero_nodos (cab->cabeza) == n);
+	COMPROBAR (cab->cola == ultimo);
+	COMPROBAR (lista_igual (cab->cabeza, ref, n));
+	if (!contar)
+		return;
+
+	for (v=0; v<=CABECERA_VALORES+CABECERA_LOTE; v++)
+	{
+		cuenta = 0;
+		for (c=0; c<n; c++)
+			cuenta += (ref[c] == v);
+		e = crear_entero (v);
+		COMPROBAR (buscar_elemento_cab (cab, e, comparar_enteros) == cuenta);
+		destruir_entero (e);
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita de ref[0..*n-1] el primer valor v (o todos si todos != 0)
+//       y devuelve cuántos quitó
+// -----------------------------------------------------------------------------
+int quitar_de_referencia (int* ref, int* n, int v, int todos)
+{
+	int c, quedan, quitados;
+
+	quedan = 0;
+	quitados = 0;
+	for (c=0; c<*n; c++)
+	{
+		if (ref[c] == v && (todos || quitados == 0))
+			quitados++;
+		else
+			ref[quedan++] = ref[c];
+	}
+	*n = quedan;
+	return quitados;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Aplica la misma secuencia de operaciones de cabecera a una lista y a un
+// vector de referencia y comprueba los invariantes tras cada una
+// -----------------------------------------------------------------------------
+void probar_variante_cabecera (int variante)
+{
+	int ref[CABECERA_MAXIMO], claves_valor[3];
+	int n, op, v, c, k, j, aux, quitados;
+	unsigned int semilla;
+	TElemento lote[CABECERA_LOTE], claves[3], e;
+	TPoolNodos* pool;
+	TCabecera cab;
+
+	pool = NULL;
+	if (variante == POOL_E_INDICE)
+	{
+		pool = crear_pool_nodos (16);
+		cab = crear_cabecera_con_pool (pool);
+	}
+	else
+		cab = crear_cabecera_vacia ();
+	if (variante == CON_INDICE || variante == POOL_E_INDICE)
+		crear_indice_hash (&cab, hash_entero, comparar_enteros);
+
+	n = 0;
+	comprobar_cabecera (&cab, ref, n, 1);
+	semilla = 11;
+	for (op=0; op<CABECERA_OPERACIONES; op++)
+	{
+		if (variante == INDICE_A_MITAD && op == CABECERA_OPERACIONES / 2)
+			crear_indice_hash (&cab, hash_entero, comparar_enteros);
+
+		v = aleatorio (&semilla, CABECERA_VALORES) + 1;
+		switch (aleatorio (&semilla, 9))
+		{
+			case 0:
+			case 1:
+				insertar_cabeza (&cab, crear_entero (v));
+				memmove (ref + 1, ref, n * sizeof(int));
+				ref[0] = v;
+				n++;
+				break;
+			case 2:
+			case 3:
+				insertar_final (&cab, crear_entero (v));
+				ref[n++] = v;
+				break;
+			case 4:
+				// Entra por la cabeza en orden inverso, como insertar_lote
+				k = aleatorio (&semilla, CABECERA_LOTE + 1);
+				memmove (ref + k, ref, n * sizeof(int));
+				for (c=0; c<k; c++)
+				{
+					lote[c] = crear_entero (v + c);
+					ref[k - 1 - c] = v + c;
+				}
+				insertar_lote_cab (&cab, lote, k);
+				n += k;
+				break;
+			case 5:
+				e = extraer_primero (&cab);
+				if (n == 0)
+					COMPROBAR (e == NULL);
+				else
+				{
+					COMPROBAR (e != NULL && valor (e) == ref[0]);
+					destruir_entero (e);
+					memmove (ref, ref + 1, (n - 1) * sizeof(int));
+					n--;
+				}
+				break;
+			case 6:
+				aux = aleatorio (&semilla, 2);
+				e = crear_entero (v);
+				borrar_elemento_cab (&cab, e, aux, comparar_enteros, destruir_entero);
+				destruir_entero (e);
+				quitar_de_referencia (ref, &n, v, aux);
+				break;
+			case 7:
+				// Claves repetidas y desordenadas a propósito
+				claves_valor[0] = v;
+				claves_valor[1] = aleatorio (&semilla, CABECERA_VALORES) + 1;
+				claves_valor[2] = v;
+				for (c=0; c<3; c++)
+					claves[c] = crear_entero (claves_valor[c]);
+				quitados = 0;
+				for (c=0; c<3; c++)
+					quitados += quitar_de_referencia (ref, &n, claves_valor[c], 1);
+				COMPROBAR (borrar_elementos_lote_cab (&cab, claves, 3, comparar_enteros, destruir_entero) == quitados);
+				for (c=0; c<3; c++)
+					destruir_entero (claves[c]);
+				break;
+			default:
+				if (aleatorio (&semilla, 8) != 0)
+					break;
+				ordenar_lista_cab (&cab, comparar_enteros);
+				for (c=1; c<n; c++)
+				{
+					aux = ref[c];
+					for (j=c; j>0 && ref[j-1]>aux; j--)
+						ref[j] = ref[j-1];
+					ref[j] = aux;
+				}
+				break;
+		}
+		comprobar_cabecera (&cab, ref, n, (op % 16) == 0);
+	}
+	comprobar_cabecera (&cab, ref, n, 1);
+
+	destruir_lista_cab (&cab, destruir_entero);
+	comprobar_cabecera (&cab, ref, 0, 1);
+
+	// Vacía y con índice sigue sirviendo
+	insertar_final (&cab, crear_entero (1));
+	ref[0] = 1;
+	comprobar_cabecera (&cab, ref, 1, 1);
+	destruir_lista_cab (&cab, destruir_entero);
+	destruir_indice_hash (&cab);
+	if (pool != NULL)
+		destruir_pool_nodos (pool);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Listas con cabecera, con y sin índice hash
+// -----------------------------------------------------------------------------
+void probar_cabecera (void)
+{
+	int variante;
+
+	for (variante=0; variante<NUM_VARIANTES; variante++)
+		probar_variante_cabecera (variante);
+}
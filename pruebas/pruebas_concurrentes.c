@@ -0,0 +1,208 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "pruebas.h"
+#include "listas_concurrentes.h"
+
+
+#define CONCURRENTES_HILOS 4
+#define CONCURRENTES_POR_HILO 20000
+#define CONCURRENTES_TOTAL (CONCURRENTES_HILOS * CONCURRENTES_POR_HILO)
+
+// Bloques pequeños para que los hilos se encuentren reservando bloques
+#define CONCURRENTES_NODOS_POR_BLOQUE 8
+
+// Trabajo de un hilo: inserta sus elementos y extrae o drena por el camino
+typedef struct hilo_concurrente
+{
+	TListaConcurrente* lista;
+	TElemento*         elementos;     // los que inserta
+	TElemento*         sacados;       // los que extrae o drena
+	int                num_sacados;
+	int                drena;
+} THiloConcurrente;
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve el número de bloques reservados por la lista
+// -----------------------------------------------------------------------------
+int bloques_concurrentes (TListaConcurrente* lista)
+{
+	TBloqueConcurrente* bloque;
+	int n = 0;
+
+	for (bloque=atomic_load (&(lista->bloques)); bloque!=NULL; bloque=bloque->sig)
+		n++;
+	return n;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Un solo hilo: orden LIFO, lista vacía, drenar en orden y reutilización de
+// los nodos devueltos
+// -----------------------------------------------------------------------------
+void probar_concurrente_secuencial (void)
+{
+	static const int v[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	static const int invertidos[] = { 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+	TListaConcurrente* lista;
+	TLista drenada;
+	TElemento e;
+	int c, bloques;
+
+	lista = crear_lista_concurrente (4);
+	COMPROBAR (extraer_cabeza (lista) == NULL);
+
+	for (c=0; c<10; c++)
+		insertar_concurrente (lista, crear_entero (v[c]));
+	for (c=9; c>=7; c--)
+	{
+		e = extraer_cabeza (lista);
+		COMPROBAR (e != NULL && valor (e) == v[c]);
+		destruir_entero (e);
+	}
+
+	drenada = drenar (lista);
+	COMPROBAR (lista_igual (drenada, invertidos + 3, 7));
+	COMPROBAR (extraer_cabeza (lista) == NULL);
+	COMPROBAR (es_lista_vacia (drenar (lista)));
+	liberar_drenados (lista, &drenada, destruir_entero);
+	COMPROBAR (es_lista_vacia (drenada));
+
+	// Los nodos extraídos y drenados se reutilizan sin reservar más bloques
+	bloques = bloques_concurrentes (lista);
+	for (c=0; c<10; c++)
+		insertar_concurrente (lista, crear_entero (v[c]));
+	COMPROBAR (bloques_concurrentes (lista) == bloques);
+
+	destruir_lista_concurrente (lista, destruir_entero);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Cuerpo de cada hilo: inserta todos sus elementos y cada dos inserciones
+// extrae uno; el que drena además vacía la lista de vez en cuando
+// -----------------------------------------------------------------------------
+void* trabajar_concurrente (void* argumento)
+{
+	THiloConcurrente* hilo = (THiloConcurrente*)argumento;
+	TLista drenada;
+	TElemento e;
+	int c;
+
+	for (c=0; c<CONCURRENTES_POR_HILO; c++)
+	{
+		insertar_concurrente (hilo->lista, hilo->elementos[c]);
+		if (c % 2 == 1)
+		{
+			e = extraer_cabeza (hilo->lista);
+			if (e != NULL)
+				hilo->sacados[hilo->num_sacados++] = e;
+		}
+		if (hilo->drena && c % 1000 == 999)
+		{
+			drenada = drenar (hilo->lista);
+			for (TNodoLista* nodo=drenada; nodo!=NULL; nodo=nodo->next)
+				hilo->sacados[hilo->num_sacados++] = nodo->dato;
+			liberar_drenados (hilo->lista, &drenada, NULL);
+		}
+	}
+	return NULL;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Varios hilos a la vez: cada elemento insertado sale exactamente una vez
+// entre lo extraído, lo drenado y lo que queda al final
+// -----------------------------------------------------------------------------
+void probar_concurrente_hilos (void)
+{
+	THiloConcurrente hilos[CONCURRENTES_HILOS];
+	pthread_t ids[CONCURRENTES_HILOS];
+	TListaConcurrente* lista;
+	TElemento* elementos;
+	TLista resto;
+	int* vistos;
+	int c, i;
+
+	elementos = malloc (CONCURRENTES_TOTAL * sizeof(TElemento));
+	vistos = calloc (CONCURRENTES_TOTAL, sizeof(int));
+	for (c=0; c<CONCURRENTES_TOTAL; c++)
+		elementos[c] = crear_entero (c);
+
+	lista = crear_lista_concurrente (CONCURRENTES_NODOS_POR_BLOQUE);
+	for (c=0; c<CONCURRENTES_HILOS; c++)
+	{
+		hilos[c].lista = lista;
+		hilos[c].elementos = elementos + c * CONCURRENTES_POR_HILO;
+		hilos[c].sacados = malloc (CONCURRENTES_TOTAL * sizeof(TElemento));
+		hilos[c].num_sacados = 0;
+		hilos[c].drena = (c == 0);
+	}
+	for (c=0; c<CONCURRENTES_HILOS; c++)
+		COMPROBAR (pthread_create (&ids[c], NULL, trabajar_concurrente, &hilos[c]) == 0);
+	for (c=0; c<CONCURRENTES_HILOS; c++)
+		pthread_join (ids[c], NULL);
+
+	for (c=0; c<CONCURRENTES_HILOS; c++)
+	{
+		for (i=0; i<hilos[c].num_sacados; i++)
+			vistos[valor (hilos[c].sacados[i])]++;
+		free (hilos[c].sacados);
+	}
+	resto = drenar (lista);
+	for (TNodoLista* nodo=resto; nodo!=NULL; nodo=nodo->next)
+		vistos[valor (nodo->dato)]++;
+
+	for (c=0; c<CONCURRENTES_TOTAL; c++)
+		if (vistos[c] != 1)
+			break;
+	COMPROBAR (c == CONCURRENTES_TOTAL);
+
+	// Cada hilo tiene como mucho la mitad de sus elementos en la lista a la
+	// vez: con reutilización no hacen falta bloques para todos
+	COMPROBAR (bloques_concurrentes (lista) * CONCURRENTES_NODOS_POR_BLOQUE < CONCURRENTES_TOTAL);
+
+	liberar_drenados (lista, &resto, NULL);
+	destruir_lista_concurrente (lista, destruir_entero);
+	for (c=0; c<CONCURRENTES_TOTAL; c++)
+		destruir_entero (elementos[c]);
+	free (elementos);
+	free (vistos);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Lista concurrente (pila de Treiber)
+// -----------------------------------------------------------------------------
+void probar_concurrentes (void)
+{
+	probar_concurrente_secuencial ();
+	probar_concurrente_hilos ();
+}
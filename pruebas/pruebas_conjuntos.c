@@ -0,0 +1,269 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include "pruebas.h"
+
+
+#define CONJUNTOS_RONDAS 300
+#define CONJUNTOS_MAXIMO 40
+#define CONJUNTOS_VALORES 12
+
+// Operaciones de conjuntos que se prueban
+enum OPERACIONES_CONJUNTO { DUPLICADOS, UNION, INTERSECCION, DIFERENCIA, NUM_OPERACIONES };
+
+// Listas de una ronda: valores y elementos de a y de b
+typedef struct ronda_conjuntos
+{
+	int       va[CONJUNTOS_MAXIMO], vb[CONJUNTOS_MAXIMO];
+	TElemento ea[CONJUNTOS_MAXIMO], eb[CONJUNTOS_MAXIMO];
+	int       na, nb;
+} TRondaConjuntos;
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve 1 si v está en v[0..n-1]
+// -----------------------------------------------------------------------------
+int contiene_valor (const int* v, int n, int x)
+{
+	int c;
+
+	for (c=0; c<n; c++)
+		if (v[c] == x)
+			return 1;
+	return 0;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Deja en esperados los elementos que debe tener el resultado en el
+//       orden de la primera aparición (el de hash) y devuelve cuántos son
+//       Cada valor se queda con el elemento de su primera aparición
+// -----------------------------------------------------------------------------
+int resultado_conjunto (TRondaConjuntos* r, int operacion, TElemento* esperados)
+{
+	int valores[2 * CONJUNTOS_MAXIMO];
+	int c, n, v, en_b;
+	TElemento e;
+
+	n = 0;
+	for (c=0; c<r->na + r->nb; c++)
+	{
+		if (c < r->na)
+		{
+			v = r->va[c];
+			e = r->ea[c];
+		}
+		else
+		{
+			if (operacion != UNION)
+				break;
+			v = r->vb[c - r->na];
+			e = r->eb[c - r->na];
+		}
+
+		en_b = contiene_valor (r->vb, r->nb, v);
+		if ((operacion == INTERSECCION && !en_b) || (operacion == DIFERENCIA && en_b))
+			continue;
+		if (contiene_valor (valores, n, v))
+			continue;
+		valores[n] = v;
+		esperados[n++] = e;
+	}
+	return n;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Ordena esperados por valor sin cambiar el orden de los iguales
+// -----------------------------------------------------------------------------
+void ordenar_esperados (TElemento* esperados, int n)
+{
+	int c, j;
+	TElemento aux;
+
+	for (c=1; c<n; c++)
+	{
+		aux = esperados[c];
+		for (j=c; j>0 && valor (esperados[j-1]) > valor (aux); j--)
+			esperados[j] = esperados[j-1];
+		esperados[j] = aux;
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Aplica la operación a *a y *b con o sin hash y con o sin pool
+// -----------------------------------------------------------------------------
+int aplicar_conjunto (int operacion, TLista* a, TLista* b, FHash hash, TPoolNodos* pool)
+{
+	switch (operacion)
+	{
+		case DUPLICADOS:
+			return (pool != NULL)
+				? eliminar_duplicados_pool (a, comparar_enteros, hash, destruir_entero, pool)
+				: eliminar_duplicados (a, comparar_enteros, hash, destruir_entero);
+		case UNION:
+			return (pool != NULL)
+				? union_listas_pool (a, b, comparar_enteros, hash, destruir_entero, pool)
+				: union_listas (a, b, comparar_enteros, hash, destruir_entero);
+		case INTERSECCION:
+			return (pool != NULL)
+				? interseccion_listas_pool (a, b, comparar_enteros, hash, destruir_entero, pool)
+				: interseccion_listas (a, b, comparar_enteros, hash, destruir_entero);
+		default:
+			return (pool != NULL)
+				? diferencia_listas_pool (a, b, comparar_enteros, hash, destruir_entero, pool)
+				: diferencia_listas (a, b, comparar_enteros, hash, destruir_entero);
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Crea la lista con los elementos e[0..n-1], con malloc o de pool
+// -----------------------------------------------------------------------------
+TLista lista_de_elementos (TElemento* e, int n, TPoolNodos* pool)
+{
+	int c;
+	TLista lista;
+
+	if (pool != NULL)
+		return crear_lista_desde_array (e, n, pool);
+
+	lista = crear_lista_vacia ();
+	for (c=n-1; c>=0; c--)
+		insertar_elemento (&lista, e[c]);
+	return lista;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Una operación sobre listas al azar, comprobando el resultado, los elementos
+// conservados, el número de descartados y lo que queda en *b
+// -----------------------------------------------------------------------------
+void probar_operacion_conjunto (int operacion, FHash hash, int con_pool, unsigned int* semilla)
+{
+	TElemento esperados[2 * CONJUNTOS_MAXIMO], eb_ordenados[CONJUNTOS_MAXIMO];
+	TRondaConjuntos r;
+	TPoolNodos* pool;
+	TLista a, b, nodo;
+	int c, n, vivos, descartados;
+
+	// Incluye listas vacías y de un elemento
+	r.na = aleatorio (semilla, CONJUNTOS_MAXIMO + 1);
+	r.nb = (operacion == DUPLICADOS) ? 0 : aleatorio (semilla, CONJUNTOS_MAXIMO + 1);
+	switch (aleatorio (semilla, 8))
+	{
+		case 0:
+			r.na = aleatorio (semilla, 2);
+			break;
+		case 1:
+			r.nb = (operacion == DUPLICADOS) ? 0 : aleatorio (semilla, 2);
+			break;
+	}
+	for (c=0; c<r.na; c++)
+	{
+		r.va[c] = aleatorio (semilla, CONJUNTOS_VALORES);
+		r.ea[c] = crear_entero (r.va[c]);
+	}
+	for (c=0; c<r.nb; c++)
+	{
+		r.vb[c] = aleatorio (semilla, CONJUNTOS_VALORES);
+		r.eb[c] = crear_entero (r.vb[c]);
+	}
+
+	n = resultado_conjunto (&r, operacion, esperados);
+	if (hash == NULL)
+		ordenar_esperados (esperados, n);
+	for (c=0; c<r.nb; c++)
+		eb_ordenados[c] = r.eb[c];
+	ordenar_esperados (eb_ordenados, r.nb);
+
+	// Con pool las dos listas salen del mismo (union_listas_pool lo exige)
+	pool = con_pool ? crear_pool_nodos (8) : NULL;
+	a = lista_de_elementos (r.ea, r.na, pool);
+	b = lista_de_elementos (r.eb, r.nb, pool);
+
+	vivos = elementos_vivos;
+	descartados = aplicar_conjunto (operacion, &a, &b, hash, pool);
+
+	// a tiene justo los elementos esperados (los mismos punteros)
+	COMPROBAR (numero_nodos (a) == n);
+	c = 0;
+	for (nodo=a; nodo!=NULL && c<n; nodo=nodo->next, c++)
+		COMPROBAR (nodo->dato == esperados[c]);
+
+	if (operacion == UNION)
+	{
+		COMPROBAR (b == NULL);
+		COMPROBAR (descartados == r.na + r.nb - n);
+	}
+	else
+	{
+		// b conserva sus elementos, ordenada si no hay hash
+		COMPROBAR (descartados == r.na - n);
+		COMPROBAR (numero_nodos (b) == r.nb);
+		c = 0;
+		for (nodo=b; nodo!=NULL && c<r.nb; nodo=nodo->next, c++)
+			COMPROBAR (nodo->dato == ((hash != NULL) ? r.eb[c] : eb_ordenados[c]));
+	}
+	COMPROBAR (elementos_vivos == vivos - descartados);
+
+	if (pool != NULL)
+	{
+		// destruir_lista_pool libera todo el pool: las dos listas a la vez
+		concatenar (&a, &b);
+		destruir_lista_pool (&a, destruir_entero, pool);
+		destruir_pool_nodos (pool);
+	}
+	else
+	{
+		destruir_lista (&a, destruir_entero);
+		destruir_lista (&b, destruir_entero);
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Operaciones de conjuntos con hash y ordenando, con malloc y con pool
+// -----------------------------------------------------------------------------
+void probar_conjuntos (void)
+{
+	int ronda, operacion, con_pool;
+	unsigned int semilla;
+
+	semilla = 24;
+	for (ronda=0; ronda<CONJUNTOS_RONDAS; ronda++)
+		for (operacion=0; operacion<NUM_OPERACIONES; operacion++)
+			for (con_pool=0; con_pool<2; con_pool++)
+			{
+				probar_operacion_conjunto (operacion, hash_entero, con_pool, &semilla);
+				probar_operacion_conjunto (operacion, NULL, con_pool, &semilla);
+			}
+}
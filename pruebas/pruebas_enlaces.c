@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "pruebas.h"
+
+
+// Las operaciones se prueban con todas las combinaciones de listas de hasta
+// ENLACES_MAXIMO elementos y posiciones hasta algo más allá del final
+#define ENLACES_MAXIMO 5
+#define ENLACES_FUERA (ENLACES_MAXIMO + 2)
+
+// Los elementos de destino se distinguen de los de origen
+#define ENLACES_DESTINO 100
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Llena v con [base, base + 1, ... base + n - 1]
+// -----------------------------------------------------------------------------
+void llenar_valores (int* v, int n, int base)
+{
+	int c;
+
+	for (c=0; c<n; c++)
+		v[c] = base + c;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Guarda en nodos los nodos de la lista en orden y devuelve cuántos son
+// -----------------------------------------------------------------------------
+int guardar_nodos (TLista lista, TNodoLista** nodos)
+{
+	int n = 0;
+
+	for (; lista != NULL; lista=lista->next)
+		nodos[n++] = lista;
+	return n;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve 1 si todos los nodos de la lista están en nodos[0..n-1]
+//       (las operaciones reenlazan, no reservan)
+// -----------------------------------------------------------------------------
+int nodos_conocidos (TLista lista, TNodoLista** nodos, int n)
+{
+	int c;
+
+	for (; lista != NULL; lista=lista->next)
+	{
+		for (c=0; c<n && nodos[c]!=lista; c++)
+			;
+		if (c == n)
+			return 0;
+	}
+	return 1;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// mover_rango con rangos vacíos, que se salen de origen, que la vacían y con
+// pos al principio, en medio y más allá del final de destino
+// -----------------------------------------------------------------------------
+void probar_mover_rango (void)
+{
+	int vo[ENLACES_MAXIMO], vd[ENLACES_MAXIMO], eo[ENLACES_MAXIMO], ed[2 * ENLACES_MAXIMO];
+	int no, nd, desde, n, pos, movidos, esperados, c, neo, ned, lugar;
+	TNodoLista* nodos[2 * ENLACES_MAXIMO];
+	TLista origen, destino;
+
+	for (no=0; no<=ENLACES_MAXIMO; no++)
+	for (nd=0; nd<=ENLACES_MAXIMO; nd++)
+	for (desde=0; desde<=ENLACES_FUERA; desde++)
+	for (n=0; n<=ENLACES_FUERA; n++)
+	for (pos=0; pos<=ENLACES_FUERA; pos++)
+	{
+		llenar_valores (vo, no, 0);
+		llenar_valores (vd, nd, ENLACES_DESTINO);
+		origen = lista_de_enteros (vo, no);
+		destino = lista_de_enteros (vd, nd);
+		c = guardar_nodos (origen, nodos);
+		guardar_nodos (destino, nodos + c);
+
+		// Resultado esperado
+		esperados = 0;
+		if (desde < no)
+			esperados = (n < no - desde) ? n : no - desde;
+		neo = 0;
+		for (c=0; c<no; c++)
+			if (c < desde || c >= desde + esperados)
+				eo[neo++] = vo[c];
+		lugar = (pos < nd) ? pos : nd;
+		ned = 0;
+		for (c=0; c<lugar; c++)
+			ed[ned++] = vd[c];
+		for (c=0; c<esperados; c++)
+			ed[ned++] = vo[desde + c];
+		for (c=lugar; c<nd; c++)
+			ed[ned++] = vd[c];
+
+		movidos = mover_rango (&origen, desde, n, &destino, pos);
+		COMPROBAR (movidos == esperados);
+		COMPROBAR (lista_igual (origen, eo, neo));
+		COMPROBAR (lista_igual (destino, ed, ned));
+		COMPROBAR (nodos_conocidos (origen, nodos, no + nd));
+		COMPROBAR (nodos_conocidos (destino, nodos, no + nd));
+
+		destruir_lista (&origen, destruir_entero);
+		destruir_lista (&destino, destruir_entero);
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// dividir_en con pos negativa, 0, en medio, al final y más allá, y concatenar
+// de vuelta las dos partes
+// -----------------------------------------------------------------------------
+void probar_dividir_concatenar (void)
+{
+	int v[ENLACES_MAXIMO], n, pos, corte;
+	TNodoLista* nodos[ENLACES_MAXIMO];
+	TLista lista, resto;
+
+	for (n=0; n<=ENLACES_MAXIMO; n++)
+	for (pos=-1; pos<=ENLACES_FUERA; pos++)
+	{
+		llenar_valores (v, n, 0);
+		lista = lista_de_enteros (v, n);
+		guardar_nodos (lista, nodos);
+
+		corte = (pos < 0) ? 0 : ((pos < n) ? pos : n);
+		resto = dividir_en (&lista, pos);
+		COMPROBAR (lista_igual (lista, v, corte));
+		COMPROBAR (lista_igual (resto, v + corte, n - corte));
+		COMPROBAR (nodos_conocidos (resto, nodos, n));
+
+		concatenar (&lista, &resto);
+		COMPROBAR (resto == NULL);
+		COMPROBAR (lista_igual (lista, v, n));
+		COMPROBAR (nodos_conocidos (lista, nodos, n));
+
+		destruir_lista (&lista, destruir_entero);
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// FPredicado: cumple si el bit valor(e) de *contexto está a 1
+// -----------------------------------------------------------------------------
+int bit_del_valor (TElemento e, void* contexto)
+{
+	return (*((int*)contexto) >> valor (e)) & 1;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// partir_por_predicado con todos los repartos posibles e invertir
+// -----------------------------------------------------------------------------
+void probar_partir_invertir (void)
+{
+	int v[ENLACES_MAXIMO], si[ENLACES_MAXIMO], no[ENLACES_MAXIMO];
+	int n, mascara, c, nsi, nno;
+	TNodoLista* nodos[ENLACES_MAXIMO];
+	TLista lista, resto;
+
+	for (n=0; n<=ENLACES_MAXIMO; n++)
+	for (mascara=0; mascara<(1 << n); mascara++)
+	{
+		llenar_valores (v, n, 0);
+		lista = lista_de_enteros (v, n);
+		guardar_nodos (lista, nodos);
+
+		nsi = 0;
+		nno = 0;
+		for (c=0; c<n; c++)
+			if ((mascara >> c) & 1)
+				si[nsi++] = c;
+			else
+				no[nno++] = c;
+
+		resto = partir_por_predicado (&lista, bit_del_valor, &mascara);
+		COMPROBAR (lista_igual (lista, si, nsi));
+		COMPROBAR (lista_igual (resto, no, nno));
+
+		concatenar (&lista, &resto);
+		invertir (&lista);
+		for (c=0; c<nsi; c++)
+			v[n - 1 - c] = si[c];
+		for (c=0; c<nno; c++)
+			v[nno - 1 - c] = no[c];
+		COMPROBAR (lista_igual (lista, v, n));
+		COMPROBAR (nodos_conocidos (lista, nodos, n));
+
+		destruir_lista (&lista, destruir_entero);
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Operaciones que reenlazan nodos
+// -----------------------------------------------------------------------------
+void probar_enlaces (void)
+{
+	probar_mover_rango ();
+	probar_dividir_concatenar ();
+	probar_partir_invertir ();
+}
@@ -0,0 +1,347 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include "pruebas.h"
+#include "listas_fichero.h"
+
+
+#define FICHERO_MAXIMO 300
+#define FICHERO_RUTA 256
+
+// Modos de guardar los elementos
+enum MODOS_FICHERO { TAM_FIJO, TAM_VARIABLE, NUM_MODOS };
+
+// Valores que ve recorrer_mapeada (FMap no lleva contexto)
+int mapeados[FICHERO_MAXIMO];
+int num_mapeados;
+
+// Elementos que crea deserializar_contando
+int deserializados;
+
+
+
+// -----------------------------------------------------------------------------
+// Serialización de los enteros: 4 bytes con tamaño fijo y, con tamaño
+// variable, además entre 0 y 10 bytes de relleno que dependen del valor
+// -----------------------------------------------------------------------------
+int tam_variable (int v)
+{
+	return (int)sizeof(int) + ((v % 11) + 11) % 11;
+}
+
+int serializar_fijo (TElemento e, void* destino, int capacidad)
+{
+	if (capacidad >= (int)sizeof(int))
+		memcpy (destino, e, sizeof(int));
+	return sizeof(int);
+}
+
+int serializar_variable (TElemento e, void* destino, int capacidad)
+{
+	int tam;
+
+	tam = tam_variable (valor (e));
+	if (capacidad >= tam)
+	{
+		memcpy (destino, e, sizeof(int));
+		memset ((char*)destino + sizeof(int), (char)valor (e), tam - sizeof(int));
+	}
+	return tam;
+}
+
+TElemento deserializar_entero (const void* origen, int tam)
+{
+	int v, c;
+
+	memcpy (&v, origen, sizeof(int));
+	COMPROBAR (tam == (int)sizeof(int) || tam == tam_variable (v));
+	for (c=sizeof(int); c<tam; c++)
+		COMPROBAR (((const char*)origen)[c] == (char)v);
+	return crear_entero (v);
+}
+
+// Para ficheros corruptos: cargar_lista no destruye lo ya creado si falla
+TElemento deserializar_contando (const void* origen, int tam)
+{
+	(void)origen;
+	(void)tam;
+	deserializados++;
+	return &deserializados;
+}
+
+void guardar_mapeado (TElemento e)
+{
+	if (num_mapeados < FICHERO_MAXIMO)
+		memcpy (&mapeados[num_mapeados], e, sizeof(int));
+	num_mapeados++;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve 1 si no existe el fichero
+// -----------------------------------------------------------------------------
+int no_existe (const char* fichero)
+{
+	return access (fichero, F_OK) != 0;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Escribe tam bytes de datos en la posición pos del fichero
+// -----------------------------------------------------------------------------
+void escribir_en (const char* fichero, long pos, const void* datos, size_t tam)
+{
+	FILE* f;
+
+	f = fopen (fichero, "r+b");
+	COMPROBAR (f != NULL);
+	if (f == NULL)
+		return;
+	COMPROBAR (fseek (f, pos, SEEK_SET) == 0);
+	COMPROBAR (fwrite (datos, 1, tam, f) == tam);
+	fclose (f);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Guarda la lista v[0..n-1] y la vuelve a leer con cargar_lista (con y sin
+// pool) y con mapear_lista
+// -----------------------------------------------------------------------------
+void probar_ida_y_vuelta (const char* fichero, const char* temporal, const int* v, int n, int modo)
+{
+	TListaMapeada* mapa;
+	TPoolNodos* pool;
+	TLista lista, cargada;
+	TElemento e;
+	int c, x, cuenta;
+
+	lista = lista_de_enteros (v, n);
+	if (modo == TAM_FIJO)
+		COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+	else
+		COMPROBAR (guardar_lista (lista, fichero, serializar_variable, 0) == 0);
+	COMPROBAR (no_existe (temporal));
+	destruir_lista (&lista, destruir_entero);
+
+	cargada = crear_lista_vacia ();
+	COMPROBAR (cargar_lista (fichero, deserializar_entero, NULL, &cargada) == n);
+	COMPROBAR (lista_igual (cargada, v, n));
+	destruir_lista (&cargada, destruir_entero);
+
+	pool = crear_pool_nodos (0);
+	cargada = crear_lista_vacia ();
+	COMPROBAR (cargar_lista (fichero, deserializar_entero, pool, &cargada) == n);
+	COMPROBAR (lista_igual (cargada, v, n));
+	destruir_lista_pool (&cargada, destruir_entero, pool);
+	destruir_pool_nodos (pool);
+
+	mapa = mapear_lista (fichero);
+	COMPROBAR (mapa != NULL);
+	if (mapa == NULL)
+		return;
+	COMPROBAR (mapa->n == n);
+	num_mapeados = 0;
+	recorrer_mapeada (mapa, guardar_mapeado);
+	COMPROBAR (num_mapeados == n);
+	for (c=0; c<n && c<num_mapeados; c++)
+		COMPROBAR (mapeados[c] == v[c]);
+
+	for (x=-3; x<=3; x++)
+	{
+		cuenta = 0;
+		for (c=0; c<n; c++)
+			cuenta += (v[c] == x);
+		e = crear_entero (x);
+		COMPROBAR (buscar_elemento_mapeada (mapa, e, comparar_enteros) == cuenta);
+		destruir_entero (e);
+	}
+	desmapear_lista (mapa);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: cargar_lista y mapear_lista rechazan el fichero antes de crear ningún
+//       elemento
+// -----------------------------------------------------------------------------
+void comprobar_rechazado (const char* fichero)
+{
+	TLista lista;
+
+	lista = crear_lista_vacia ();
+	deserializados = 0;
+	COMPROBAR (cargar_lista (fichero, deserializar_contando, NULL, &lista) == -1);
+	COMPROBAR (lista == NULL);
+	COMPROBAR (deserializados == 0);
+	COMPROBAR (mapear_lista (fichero) == NULL);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: cargar_lista rechaza el fichero y la vista proyectada se detiene antes
+//       de salirse de él (tamaño variable: sólo se sabe al recorrer)
+// -----------------------------------------------------------------------------
+void comprobar_recortado (const char* fichero, int n)
+{
+	TListaMapeada* mapa;
+	TLista lista;
+
+	lista = crear_lista_vacia ();
+	COMPROBAR (cargar_lista (fichero, deserializar_contando, NULL, &lista) == -1);
+	COMPROBAR (lista == NULL);
+
+	mapa = mapear_lista (fichero);
+	COMPROBAR (mapa != NULL);
+	if (mapa == NULL)
+		return;
+	num_mapeados = 0;
+	recorrer_mapeada (mapa, guardar_mapeado);
+	COMPROBAR (num_mapeados < n);
+	desmapear_lista (mapa);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Ficheros que no existen, con cabecera inválida, recortados o con tamaños
+// que se salen del fichero
+// -----------------------------------------------------------------------------
+void probar_ficheros_corruptos (const char* fichero, const int* v, int n)
+{
+	TLista lista;
+	uint64_t enorme;
+	uint32_t version, tam;
+
+	lista = lista_de_enteros (v, n);
+
+	unlink (fichero);
+	comprobar_rechazado (fichero);
+
+	COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+	escribir_en (fichero, 0, "XXXX", 4);
+	comprobar_rechazado (fichero);
+
+	COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+	version = FICHERO_LISTA_VERSION + 1;
+	escribir_en (fichero, offsetof(TCabeceraFichero, version), &version, sizeof(version));
+	comprobar_rechazado (fichero);
+
+	COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+	enorme = (uint64_t)1 << 40;
+	escribir_en (fichero, offsetof(TCabeceraFichero, n), &enorme, sizeof(enorme));
+	comprobar_rechazado (fichero);
+
+	// Más elementos de los que caben, aunque sean pocos
+	COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+	enorme = n + 1;
+	escribir_en (fichero, offsetof(TCabeceraFichero, n), &enorme, sizeof(enorme));
+	comprobar_rechazado (fichero);
+
+	COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+	COMPROBAR (truncate (fichero, sizeof(TCabeceraFichero) + 8 * (n / 2)) == 0);
+	comprobar_rechazado (fichero);
+
+	COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+	COMPROBAR (truncate (fichero, sizeof(TCabeceraFichero) / 2) == 0);
+	comprobar_rechazado (fichero);
+
+	COMPROBAR (guardar_lista (lista, fichero, serializar_variable, 0) == 0);
+	COMPROBAR (truncate (fichero, sizeof(TCabeceraFichero) + 16 * (n / 2)) == 0);
+	comprobar_recortado (fichero, n);
+
+	// Primer registro con un tamaño que se sale del fichero
+	COMPROBAR (guardar_lista (lista, fichero, serializar_variable, 0) == 0);
+	tam = 1u << 30;
+	escribir_en (fichero, sizeof(TCabeceraFichero) + offsetof(TRegistroFichero, tam), &tam, sizeof(tam));
+	comprobar_recortado (fichero, n);
+
+	destruir_lista (&lista, destruir_entero);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Un guardado que falla no deja el fichero a medias ni toca el anterior
+// -----------------------------------------------------------------------------
+void probar_guardado_fallido (const char* fichero, const char* temporal, const int* v, int n)
+{
+	TLista lista, cargada;
+
+	lista = lista_de_enteros (v, n);
+	COMPROBAR (guardar_lista (lista, fichero, serializar_fijo, sizeof(int)) == 0);
+
+	// Con tamaño fijo todos deben ocupar lo mismo y con relleno no es así
+	COMPROBAR (guardar_lista (lista, fichero, serializar_variable, sizeof(int)) == -1);
+	COMPROBAR (no_existe (temporal));
+
+	cargada = crear_lista_vacia ();
+	COMPROBAR (cargar_lista (fichero, deserializar_entero, NULL, &cargada) == n);
+	COMPROBAR (lista_igual (cargada, v, n));
+	destruir_lista (&cargada, destruir_entero);
+	destruir_lista (&lista, destruir_entero);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Listas en fichero: guardar_lista, cargar_lista y mapear_lista
+// -----------------------------------------------------------------------------
+void probar_fichero (void)
+{
+	static const int longitudes[] = { 0, 1, 2, 7, FICHERO_MAXIMO };
+	char fichero[FICHERO_RUTA], temporal[FICHERO_RUTA + 4];
+	int v[FICHERO_MAXIMO];
+	const char* directorio;
+	unsigned int semilla;
+	int c, l, modo;
+
+	directorio = getenv ("TMPDIR");
+	if (directorio == NULL || directorio[0] == '\0')
+		directorio = "/tmp";
+	snprintf (fichero, sizeof(fichero), "%s/pruebas_listas_%ld.lst", directorio, (long)getpid ());
+	snprintf (temporal, sizeof(temporal), "%s.tmp", fichero);
+
+	semilla = 16;
+	for (l=0; l<(int)(sizeof(longitudes) / sizeof(longitudes[0])); l++)
+		for (modo=0; modo<NUM_MODOS; modo++)
+		{
+			for (c=0; c<longitudes[l]; c++)
+				v[c] = aleatorio (&semilla, 2001) - 1000;
+			// Algunos repetidos para buscar_elemento_mapeada
+			for (c=0; c<longitudes[l]; c+=3)
+				v[c] = aleatorio (&semilla, 7) - 3;
+			probar_ida_y_vuelta (fichero, temporal, v, longitudes[l], modo);
+		}
+
+	probar_guardado_fallido (fichero, temporal, v, FICHERO_MAXIMO);
+	probar_ficheros_corruptos (fichero, v, FICHERO_MAXIMO);
+	unlink (fichero);
+}
@@ -0,0 +1,240 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "pruebas.h"
+#include "listas_paralelas.h"
+
+
+// Listas de hasta PARALELAS_MAXIMO elementos: la mayor supera el umbral a
+// partir del que ordenar_lista_paralelo reparte el trabajo
+#define PARALELAS_MAXIMO 70000
+#define PARALELAS_INTERNA 1000
+
+// Los elementos de estas pruebas son el propio número (no hay que reservar
+// nada desde los hilos). Con ordenar se compara sólo por la parte alta
+#define ENTERO(v) ((TElemento)(intptr_t)(v))
+#define VALOR(e) ((int)(intptr_t)(e))
+#define CLAVE_ORDEN(e) (VALOR(e) >> 8)
+
+// Funciones afines x -> a*x + b módulo PARALELAS_PRIMO en un entero (a en los
+// 16 bits altos): componerlas es asociativo pero no conmutativo, así el
+// resultado de reducir_paralelo depende del orden en que se combinan
+#define PARALELAS_PRIMO 32749
+#define AFIN(a, b) ENTERO(((a) << 16) | (b))
+#define AFIN_A(e) (VALOR(e) >> 16)
+#define AFIN_B(e) (VALOR(e) & 0xFFFF)
+
+// Veces que recorrer_paralelo pasa por cada elemento
+_Atomic int visitas[PARALELAS_MAXIMO];
+
+// Lista que reducen las llamadas anidadas y suma de sus resultados
+TLista interna;
+_Atomic long suma_anidada;
+
+
+
+void no_destruir (TElemento e)
+{
+	(void)e;
+}
+
+void visitar (TElemento e)
+{
+	atomic_fetch_add_explicit (&visitas[VALOR(e)], 1, memory_order_relaxed);
+}
+
+// Sin signo para que la suma de la lista larga dé la vuelta sin desbordar
+TElemento sumar (TElemento acumulado, TElemento e)
+{
+	return (TElemento)((uintptr_t)acumulado + (uintptr_t)e);
+}
+
+// Aplica primero acumulado y después e
+TElemento componer (TElemento acumulado, TElemento e)
+{
+	return AFIN((AFIN_A(e) * AFIN_A(acumulado)) % PARALELAS_PRIMO,
+	            (AFIN_A(e) * AFIN_B(acumulado) + AFIN_B(e)) % PARALELAS_PRIMO);
+}
+
+int comparar_clave_orden (TElemento e1, TElemento e2)
+{
+	return (CLAVE_ORDEN(e1) > CLAVE_ORDEN(e2)) - (CLAVE_ORDEN(e1) < CLAVE_ORDEN(e2));
+}
+
+// map que hace dentro otra operación paralela
+void reducir_dentro (TElemento e)
+{
+	TElemento suma;
+
+	suma = reducir_paralelo (interna, sumar, ENTERO(0), 4);
+	atomic_fetch_add (&suma_anidada, (long)VALOR(suma) * VALOR(e));
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Devuelve la lista [v[0], ..., v[n-1]] de elementos ENTERO
+// -----------------------------------------------------------------------------
+TLista lista_de_numeros (const int* v, int n)
+{
+	int c;
+	TLista lista;
+
+	lista = crear_lista_vacia ();
+	for (c=n-1; c>=0; c--)
+		insertar_elemento (&lista, ENTERO(v[c]));
+	return lista;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// recorrer_paralelo y reducir_paralelo con n elementos y hilos hilos
+// -----------------------------------------------------------------------------
+void probar_recorrer_reducir (int* v, int n, int hilos, unsigned int* semilla)
+{
+	TElemento resultado, esperado;
+	TLista lista;
+	uintptr_t suma;
+	int c;
+
+	for (c=0; c<n; c++)
+	{
+		v[c] = c;
+		atomic_init (&visitas[c], 0);
+	}
+	lista = lista_de_numeros (v, n);
+	recorrer_paralelo (lista, visitar, hilos);
+	for (c=0; c<n && atomic_load (&visitas[c]) == 1; c++)
+		;
+	COMPROBAR (c == n);
+
+	suma = 0;
+	for (c=0; c<n; c++)
+		suma += (uintptr_t)v[c];
+	resultado = reducir_paralelo (lista, sumar, ENTERO(0), hilos);
+	COMPROBAR ((uintptr_t)resultado == suma);
+	destruir_lista (&lista, no_destruir);
+
+	// Orden de combinación
+	esperado = AFIN(1, 0);
+	for (c=0; c<n; c++)
+	{
+		v[c] = VALOR(AFIN(aleatorio (semilla, PARALELAS_PRIMO), aleatorio (semilla, PARALELAS_PRIMO)));
+		esperado = componer (esperado, ENTERO(v[c]));
+	}
+	lista = lista_de_numeros (v, n);
+	resultado = reducir_paralelo (lista, componer, AFIN(1, 0), hilos);
+	COMPROBAR (resultado == esperado);
+	destruir_lista (&lista, no_destruir);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// ordenar_lista_paralelo da la misma lista que ordenar_lista (también el
+// orden de los iguales)
+// -----------------------------------------------------------------------------
+void probar_ordenar_paralelo (int* v, int n, int hilos, unsigned int* semilla)
+{
+	TLista secuencial, paralela, a, b;
+	int c;
+
+	// El número de orden en los bits bajos distingue los iguales
+	for (c=0; c<n; c++)
+		v[c] = (aleatorio (semilla, 1000) << 8) | (c & 0xFF);
+	secuencial = lista_de_numeros (v, n);
+	paralela = lista_de_numeros (v, n);
+
+	ordenar_lista (&secuencial, comparar_clave_orden);
+	ordenar_lista_paralelo (&paralela, comparar_clave_orden, hilos);
+	for (a=secuencial, b=paralela; a!=NULL && b!=NULL && a->dato==b->dato; a=a->next, b=b->next)
+		;
+	COMPROBAR (a == NULL && b == NULL);
+
+	destruir_lista (&secuencial, no_destruir);
+	destruir_lista (&paralela, no_destruir);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Una operación paralela llamada desde dentro de otra se hace en el hilo que
+// la llama en lugar de esperar a un pool ocupado
+// -----------------------------------------------------------------------------
+void probar_anidadas (int* v)
+{
+	TLista externa;
+	long esperada;
+	int c;
+
+	for (c=0; c<PARALELAS_INTERNA; c++)
+		v[c] = c + 1;
+	interna = lista_de_numeros (v, PARALELAS_INTERNA);
+	externa = lista_de_numeros (v, PARALELAS_INTERNA);
+
+	atomic_init (&suma_anidada, 0);
+	recorrer_paralelo (externa, reducir_dentro, 4);
+	esperada = 0;
+	for (c=0; c<PARALELAS_INTERNA; c++)
+		esperada += (long)v[c];
+	esperada *= esperada;
+	COMPROBAR (atomic_load (&suma_anidada) == esperada);
+
+	destruir_lista (&interna, no_destruir);
+	destruir_lista (&externa, no_destruir);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Recorridos, reducciones y ordenación en paralelo con listas vacías, cortas
+// y largas y distinto número de hilos, antes y después de terminar el pool
+// -----------------------------------------------------------------------------
+void probar_paralelas (void)
+{
+	static const int longitudes[] = { 0, 1, 2, 17, 1000, PARALELAS_MAXIMO };
+	static const int num_hilos[] = { 1, 2, 3, 8 };
+	unsigned int semilla;
+	int* v;
+	int l, h, vuelta;
+
+	v = malloc (PARALELAS_MAXIMO * sizeof(int));
+	semilla = 9;
+	for (vuelta=0; vuelta<2; vuelta++)
+	{
+		for (l=0; l<(int)(sizeof(longitudes) / sizeof(longitudes[0])); l++)
+			for (h=0; h<(int)(sizeof(num_hilos) / sizeof(num_hilos[0])); h++)
+			{
+				probar_recorrer_reducir (v, longitudes[l], num_hilos[h], &semilla);
+				probar_ordenar_paralelo (v, longitudes[l], num_hilos[h], &semilla);
+			}
+		probar_anidadas (v);
+
+		// La segunda vuelta vuelve a crear los hilos
+		terminar_hilos_paralelos ();
+	}
+	free (v);
+}
@@ -0,0 +1,204 @@
+/*
+Copyright (c) 2010 Javier Carmena (git@github.com:jcarmena/listas.git)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "pruebas.h"
+#include "listas_persistentes.h"
+
+
+#define PERSISTENTES_OPERACIONES 3000
+#define PERSISTENTES_VERSIONES 6
+#define PERSISTENTES_VALORES 8
+#define PERSISTENTES_MAXIMO PERSISTENTES_OPERACIONES
+
+// Una versión de la lista y lo que debe contener
+typedef struct version_persistente
+{
+	TListaPersistente lista;
+	int               viva;
+	int               n;
+	int               valores[PERSISTENTES_MAXIMO];
+} TVersionPersistente;
+
+// Elementos que ve recorrer_persistente (FMap no lleva contexto)
+TElemento recorridos[PERSISTENTES_VERSIONES * PERSISTENTES_MAXIMO];
+int num_recorridos;
+
+
+
+void guardar_recorrido (TElemento e)
+{
+	recorridos[num_recorridos++] = e;
+}
+
+int comparar_punteros (const void* a, const void* b)
+{
+	TElemento e1 = *((const TElemento*)a);
+	TElemento e2 = *((const TElemento*)b);
+
+	return (e1 > e2) - (e1 < e2);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Comprueba que cada versión viva tiene sus valores y que sólo quedan
+//       sin destruir los elementos que ve alguna versión
+// -----------------------------------------------------------------------------
+void comprobar_versiones (TVersionPersistente* versiones)
+{
+	int c, i, inicio, distintos, cuenta;
+	TElemento e;
+
+	num_recorridos = 0;
+	for (c=0; c<PERSISTENTES_VERSIONES; c++)
+	{
+		if (!versiones[c].viva)
+			continue;
+		inicio = num_recorridos;
+		recorrer_persistente (versiones[c].lista, guardar_recorrido);
+		COMPROBAR (num_recorridos - inicio == versiones[c].n);
+		for (i=0; i<versiones[c].n && inicio+i<num_recorridos; i++)
+			COMPROBAR (valor (recorridos[inicio + i]) == versiones[c].valores[i]);
+	}
+
+	// Elementos distintos que se ven desde alguna versión
+	qsort (recorridos, num_recorridos, sizeof(TElemento), comparar_punteros);
+	distintos = 0;
+	for (i=0; i<num_recorridos; i++)
+		distintos += (i == 0 || recorridos[i] != recorridos[i-1]);
+	COMPROBAR (elementos_vivos == distintos);
+
+	for (c=0; c<PERSISTENTES_VERSIONES; c++)
+	{
+		if (!versiones[c].viva)
+			continue;
+		e = crear_entero (c % PERSISTENTES_VALORES);
+		cuenta = 0;
+		for (i=0; i<versiones[c].n; i++)
+			cuenta += (versiones[c].valores[i] == valor (e));
+		COMPROBAR (buscar_persistente (versiones[c].lista, e, comparar_enteros) == cuenta);
+		destruir_entero (e);
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// POST: Quita de la versión el primer valor v (o todos si todos != 0) y
+//       devuelve cuántos quitó
+// -----------------------------------------------------------------------------
+int quitar_de_version (TVersionPersistente* version, int v, int todos)
+{
+	int c, quedan, quitados;
+
+	quedan = 0;
+	quitados = 0;
+	for (c=0; c<version->n; c++)
+	{
+		if (version->valores[c] == v && (todos || quitados == 0))
+			quitados++;
+		else
+			version->valores[quedan++] = version->valores[c];
+	}
+	version->n = quedan;
+	return quitados;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Listas persistentes: inserciones, borrados, instantáneas y liberaciones
+// sobre varias versiones que comparten nodos. Cualquier versión se puede
+// modificar sin que cambien las demás
+// -----------------------------------------------------------------------------
+void probar_persistentes (void)
+{
+	static TVersionPersistente versiones[PERSISTENTES_VERSIONES];
+	int op, c, v, todos, destino, quitados;
+	unsigned int semilla;
+	TElemento e;
+
+	for (c=0; c<PERSISTENTES_VERSIONES; c++)
+		versiones[c].viva = 0;
+	versiones[0].lista = crear_lista_persistente ();
+	versiones[0].viva = 1;
+	versiones[0].n = 0;
+
+	semilla = 20;
+	for (op=0; op<PERSISTENTES_OPERACIONES; op++)
+	{
+		c = aleatorio (&semilla, PERSISTENTES_VERSIONES);
+		if (!versiones[c].viva)
+			c = 0;
+		v = aleatorio (&semilla, PERSISTENTES_VALORES);
+
+		switch (aleatorio (&semilla, 6))
+		{
+			case 0:
+			case 1:
+				if (versiones[c].n == PERSISTENTES_MAXIMO)
+					break;
+				insertar_persistente (&versiones[c].lista, crear_entero (v));
+				memmove (versiones[c].valores + 1, versiones[c].valores, versiones[c].n * sizeof(int));
+				versiones[c].valores[0] = v;
+				versiones[c].n++;
+				break;
+			case 2:
+			case 3:
+				todos = aleatorio (&semilla, 2);
+				e = crear_entero (v);
+				quitados = quitar_de_version (&versiones[c], v, todos);
+				COMPROBAR (borrar_persistente (&versiones[c].lista, e, todos, comparar_enteros, destruir_entero) == quitados);
+				destruir_entero (e);
+				break;
+			case 4:
+				// Instantánea en un hueco libre
+				for (destino=0; destino<PERSISTENTES_VERSIONES && versiones[destino].viva; destino++)
+					;
+				if (destino == PERSISTENTES_VERSIONES)
+					break;
+				versiones[destino].lista = instantanea (versiones[c].lista);
+				versiones[destino].viva = 1;
+				versiones[destino].n = versiones[c].n;
+				memcpy (versiones[destino].valores, versiones[c].valores, versiones[c].n * sizeof(int));
+				break;
+			default:
+				if (c == 0)
+					break;
+				liberar_persistente (&versiones[c].lista, destruir_entero);
+				COMPROBAR (versiones[c].lista == NULL);
+				versiones[c].viva = 0;
+				break;
+		}
+		comprobar_versiones (versiones);
+	}
+
+	for (c=0; c<PERSISTENTES_VERSIONES; c++)
+		if (versiones[c].viva)
+		{
+			liberar_persistente (&versiones[c].lista, destruir_entero);
+			versiones[c].viva = 0;
+			comprobar_versiones (versiones);
+		}
+}
@@ -20,8 +20,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "listas.h"
 
 
@@ -46,6 +53,94 @@ typedef struct comando
 	int argumento;
 } TComando;
 
+// Palabra de cada comando y si lleva argumento
+typedef struct definicion_comando
+{
+	const char* palabra;
+	TCodigoComando codigo;
+	int con_argumento;
+} TDefinicionComando;
+
+const TDefinicionComando comandos[] =
+{
+	{ COMANDO_SALIR, SALIR, 0 },
+	{ COMANDO_MOSTRAR, MOSTRAR, 0 },
+	{ COMANDO_ORDENAR, ORDENAR, 0 },
+	{ COMANDO_AYUDA, AYUDA, 0 },
+	{ COMANDO_INSERTAR, INSERTAR, 1 },
+	{ COMANDO_BORRAR, BORRAR, 1 },
+	{ COMANDO_BUSCAR, BUSCAR, 1 },
+	{ COMANDO_BORRARTODOS, BORRARTODOS, 1 }
+};
+
+#define NUM_COMANDOS ((int)(sizeof(comandos) / sizeof(comandos[0])))
+
+// Tamaño del búfer de salida
+#define TAM_SALIDA 65536
+
+// Tamaño de los bloques en que se lee una entrada que no se puede proyectar
+#define TAM_BLOQUE_ENTRADA (1 << 20)
+
+// Salida acumulada pendiente de escribir
+char salida[TAM_SALIDA];
+int usados_salida = 0;
+
+
+
+// -----------------------------------------------------------------------------
+// Escribe en stdout lo acumulado en el búfer de salida
+// -----------------------------------------------------------------------------
+void vaciar_salida (void)
+{
+	fwrite (salida, 1, usados_salida, stdout);
+	usados_salida = 0;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Añade n caracteres al búfer de salida
+// -----------------------------------------------------------------------------
+void escribir_texto (const char* txt, int n)
+{
+	if (usados_salida + n > TAM_SALIDA)
+		vaciar_salida();
+	
+	if (n > TAM_SALIDA)
+		fwrite (txt, 1, n, stdout);
+	else
+	{
+		memcpy (salida + usados_salida, txt, n);
+		usados_salida += n;
+	}
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Añade un entero en decimal al búfer de salida
+// -----------------------------------------------------------------------------
+void escribir_entero (int v)
+{
+	char txt[12];
+	unsigned int u;
+	int i;
+	
+	// Se escribe desde el final; u evita el desbordamiento de -INT_MIN
+	i = sizeof(txt);
+	u = (v < 0) ? -(unsigned int)v : (unsigned int)v;
+	do
+	{
+		txt[--i] = '0' + u % 10;
+		u /= 10;
+	}
+	while (u > 0);
+	if (v < 0)
+		txt[--i] = '-';
+	
+	escribir_texto (txt + i, sizeof(txt) - i);
+}
+
 
 
 // -----------------------------------------------------------------------------
@@ -67,7 +162,8 @@ int comparar_elementos (void* a, void* b)
 // -----------------------------------------------------------------------------
 void mostrar_elemento (TElemento e)
 {
-	printf ("%d ", *((int*)e));
+	escribir_entero (*((int*)e));
+	escribir_texto (" ", 1);
 }
 
 
@@ -100,20 +196,26 @@ TElemento crear_elemento (int e)
 
 
 // -----------------------------------------------------------------------------
-// Pide por pantalla n elementos y devuelve una lista nueva creada a partir de ellos
+// Pide por pantalla n elementos y devuelve una lista nueva creada a partir de
+// ellos, con los nodos de pool reservados de una vez
 // -----------------------------------------------------------------------------
-TLista pedir_elementos (int n)
+TLista pedir_elementos (int n, TPoolNodos* pool)
 {
 	int c, valor;
 	TLista lista;
+	TElemento* v;
 	
-	lista = crear_lista_vacia();
+	v = malloc (n * sizeof(TElemento));
 	for (c=0; c<n; c++)
 	{
 		printf ("Introduce el elemento número %d: ", c+1);
 		scanf ("%d", &valor);
-		insertar_elemento (&lista, crear_elemento(valor));
+		v[c] = crear_elemento(valor);
 	}
+	
+	lista = crear_lista_vacia();
+	insertar_lote_pool (&lista, v, n, pool);
+	free (v);
 	return lista;
 }
 
@@ -138,62 +240,50 @@ void mostrar_ayuda ()
 }
 
 
+// -----------------------------------------------------------------------------
+// Devuelve la posición en comandos del comando de los n caracteres de txt, o
+// -1 si no es ninguno
+// -----------------------------------------------------------------------------
+int buscar_comando (const char* txt, int n)
+{
+	int i;
+	
+	for (i=0; i<NUM_COMANDOS; i++)
+	{
+		if (((int)strlen(comandos[i].palabra) == n) && (memcmp(txt, comandos[i].palabra, n) == 0))
+			return i;
+	}
+	return -1;
+}
+
+
+
 // -----------------------------------------------------------------------------
 // Pide por pantalla que se introduzca el siguiente comando
 // Si introduce uno incorrecto vuelve a pedirlo
-// Devuelve un puntero a la estructura TComando con la información introducida
-// por el usuario
+// Deja en comando la información introducida por el usuario (SALIR si se
+// acaba la entrada)
 // -----------------------------------------------------------------------------
-TComando* pedir_comando (void)
+void pedir_comando (TComando* comando)
 {
-	TComando* comando;
 	char txt[20];
-	int arg;
-	int ok;
-
-	comando = malloc(sizeof(TComando));
-	ok = 0;
+	int i;
 	
-	while (!ok)
+	i = -1;
+	while (i < 0)
 	{
 		printf ("\n> ");
-		scanf ("%s", txt); 
-		if (strcmp(txt, COMANDO_SALIR) == 0)	{
+		if (scanf ("%19s", txt) != 1)
+		{
 			comando->codigo = SALIR;
-			ok = 1;
-		} else if (strcmp(txt, COMANDO_MOSTRAR) == 0)	{
-			comando->codigo = MOSTRAR;
-			ok = 1;
-		} else if (strcmp(txt, COMANDO_ORDENAR) == 0)	{
-			comando->codigo = ORDENAR;
-			ok = 1;
-		} else if (strcmp(txt, COMANDO_AYUDA) == 0)	{
-			comando->codigo = AYUDA;
-			ok = 1;
-		} else if (strcmp(txt, COMANDO_INSERTAR) == 0)	{
-			scanf ("%d", &arg);
-			comando->codigo = INSERTAR;
-			comando->argumento = arg;
-			ok = 1;
-		} else if (strcmp(txt, COMANDO_BORRAR) == 0)	{
-			scanf ("%d", &arg);
-			comando->codigo = BORRAR;
-			comando->argumento = arg;
-			ok = 1;
-		} else if (strcmp(txt, COMANDO_BUSCAR) == 0)	{
-			scanf ("%d", &arg);
-			comando->codigo = BUSCAR;
-			comando->argumento = arg;
-			ok = 1;
-		} else if (strcmp(txt, COMANDO_BORRARTODOS) == 0)	{
-			scanf ("%d", &arg);
-			comando->codigo = BORRARTODOS;
-			comando->argumento = arg;
-			ok = 1;
+			return;
 		}
+		i = buscar_comando (txt, strlen(txt));
 	}
-		
-	return comando;
+	
+	comando->codigo = comandos[i].codigo;
+	if (comandos[i].con_argumento)
+		scanf ("%d", &comando->argumento);
 }
 
 
@@ -203,9 +293,218 @@ TComando* pedir_comando (void)
 // -----------------------------------------------------------------------------
 void mostrar_lista (TLista lista)
 {
-	printf("[ ");
+	escribir_texto ("[ ", 2);
 	recorrer (lista, mostrar_elemento);
-	printf("]");
+	escribir_texto ("]", 1);
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Lee la entrada completa de un fichero (o de stdin si es "-")
+// Los ficheros normales se proyectan en memoria, el resto se lee por bloques
+// grandes. Devuelve NULL si no se puede leer; *proyectado indica si hay que
+// liberarla con munmap en vez de free
+// -----------------------------------------------------------------------------
+char* leer_entrada (const char* fichero, size_t* tam, int* proyectado)
+{
+	struct stat info;
+	char* texto;
+	size_t capacidad;
+	ssize_t leidos;
+	int fd;
+	
+	fd = (strcmp(fichero, "-") == 0) ? STDIN_FILENO : open (fichero, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+	
+	*proyectado = 0;
+	if ((fstat (fd, &info) == 0) && S_ISREG(info.st_mode) && (info.st_size > 0))
+	{
+		texto = mmap (NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (texto != MAP_FAILED)
+		{
+			if (fd != STDIN_FILENO)
+				close (fd);
+			*tam = info.st_size;
+			*proyectado = 1;
+			return texto;
+		}
+	}
+	
+	capacidad = TAM_BLOQUE_ENTRADA;
+	texto = malloc (capacidad);
+	*tam = 0;
+	while ((leidos = read (fd, texto + *tam, capacidad - *tam)) != 0)
+	{
+		if (leidos < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			
+			// Un error de lectura no es el final de la entrada
+			perror (fichero);
+			free (texto);
+			texto = NULL;
+			break;
+		}
+		
+		*tam += leidos;
+		if (*tam == capacidad)
+		{
+			capacidad *= 2;
+			texto = realloc (texto, capacidad);
+		}
+	}
+	if (fd != STDIN_FILENO)
+		close (fd);
+	return texto;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Deja en *token el comienzo de la siguiente palabra a partir de *cursor y
+// devuelve su longitud (0 si no quedan). *cursor queda detrás de la palabra
+// No copia nada: la palabra es un trozo de la entrada
+// -----------------------------------------------------------------------------
+int siguiente_token (const char** cursor, const char* fin, const char** token)
+{
+	const char* c;
+	
+	c = *cursor;
+	while ((c < fin) && ((*c == ' ') || (*c == '\t') || (*c == '\n') || (*c == '\r')))
+		c++;
+	
+	*token = c;
+	while ((c < fin) && (*c != ' ') && (*c != '\t') && (*c != '\n') && (*c != '\r'))
+		c++;
+	
+	*cursor = c;
+	return c - *token;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Convierte los n caracteres de txt en un entero. Devuelve 0 si no lo es
+// -----------------------------------------------------------------------------
+int leer_entero (const char* txt, int n, int* valor)
+{
+	int i, negativo;
+	long v;
+	
+	negativo = (n > 0) && (txt[0] == '-');
+	i = negativo;
+	if (i >= n)
+		return 0;
+	
+	v = 0;
+	for (; i<n; i++)
+	{
+		if ((txt[i] < '0') || (txt[i] > '9') || (v > 2147483648L))
+			return 0;
+		v = v * 10 + (txt[i] - '0');
+	}
+	
+	v = negativo ? -v : v;
+	if ((v < -2147483647L - 1) || (v > 2147483647L))
+		return 0;
+	*valor = (int)v;
+	return 1;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Ejecuta sin preguntar los comandos de un fichero (o de stdin si es "-"),
+// partiendo de una lista vacía. Sólo escriben mostrar (la lista) y buscar
+// (las ocurrencias), una línea por comando; los errores van a stderr
+// Devuelve 0 si pudo leer la entrada
+// -----------------------------------------------------------------------------
+int ejecutar_lote (const char* fichero)
+{
+	TLista lista;
+	TComando comando;
+	const char* texto;
+	const char* cursor;
+	const char* siguiente;
+	const char* fin;
+	const char* token;
+	size_t tam;
+	int n, i, proyectado;
+	
+	texto = leer_entrada (fichero, &tam, &proyectado);
+	if (texto == NULL)
+	{
+		fprintf (stderr, "No se puede leer %s\n", fichero);
+		return 1;
+	}
+	
+	lista = crear_lista_vacia();
+	cursor = texto;
+	fin = texto + tam;
+	while ((n = siguiente_token (&cursor, fin, &token)) > 0)
+	{
+		i = buscar_comando (token, n);
+		if (i < 0)
+		{
+			fprintf (stderr, "Comando desconocido: %.*s\n", n, token);
+			continue;
+		}
+		
+		comando.codigo = comandos[i].codigo;
+		if (comandos[i].con_argumento)
+		{
+			// Si no hay valor la palabra siguiente se toma como otro comando
+			siguiente = cursor;
+			n = siguiente_token (&siguiente, fin, &token);
+			if (!leer_entero (token, n, &comando.argumento))
+			{
+				fprintf (stderr, "Falta el valor de %s\n", comandos[i].palabra);
+				continue;
+			}
+			cursor = siguiente;
+		}
+		
+		if (comando.codigo == SALIR)
+			break;
+		
+		switch (comando.codigo)
+		{
+			case MOSTRAR:
+				mostrar_lista (lista);
+				escribir_texto ("\n", 1);
+				break;
+			case ORDENAR:
+				ordenar_lista (&lista, comparar_elementos);
+				break;
+			case INSERTAR:
+				insertar_elemento (&lista, crear_elemento(comando.argumento));
+				break;
+			case BORRAR:
+				borrar_elemento (&lista, (void*)(&comando.argumento), 0, comparar_elementos, destruir_elemento);
+				break;
+			case BORRARTODOS:
+				borrar_elemento (&lista, (void*)(&comando.argumento), 1, comparar_elementos, destruir_elemento);
+				break;
+			case BUSCAR:
+				escribir_entero (buscar_elemento (lista, (void*)(&comando.argumento), comparar_elementos));
+				escribir_texto (" ocurrencias\n", 13);
+				break;
+			default:
+				break;
+		}
+	}
+	vaciar_salida();
+	
+	if (proyectado)
+		munmap ((void*)texto, tam);
+	else
+		free ((void*)texto);
+	destruir_lista (&lista, destruir_elemento);
+	
+	return 0;
 }
 
 
@@ -217,11 +516,16 @@ int main (int argc, char* argv[])
 {
 	int num;
 	TLista lista;
-	TComando* comando;
+	TPoolNodos* pool;
+	TComando comando;
+	
+	if ((argc == 3) && (strcmp(argv[1], "-f") == 0))
+		return ejecutar_lote (argv[2]);
 	
 	if (argc != 2)
 	{
 		printf ("\n%s: Uso incorrecto: %s <número de elementos>\n", argv[0], argv[0]);
+		printf ("%s -f <fichero de comandos, - para stdin>\n", argv[0]);
 		return 1;
 	}
 	
@@ -229,12 +533,13 @@ int main (int argc, char* argv[])
 	if (num < 1)
 		return 0;
 		
-	lista = pedir_elementos (num);
+	pool = crear_pool_nodos (0);
+	lista = pedir_elementos (num, pool);
 	mostrar_ayuda();	
-	comando = pedir_comando();
-	while (comando->codigo != SALIR)
+	pedir_comando(&comando);
+	while (comando.codigo != SALIR)
 	{
-		switch (comando->codigo)
+		switch (comando.codigo)
 		{
 			case MOSTRAR:
 				mostrar_lista(lista);
@@ -244,33 +549,35 @@ int main (int argc, char* argv[])
 				mostrar_lista(lista);
 				break;
 			case INSERTAR:
-				insertar_elemento (&lista, crear_elemento(comando->argumento));
+				insertar_elemento_pool (&lista, crear_elemento(comando.argumento), pool);
 				mostrar_lista(lista);
 				break;
 			case BORRAR:
-				borrar_elemento (&lista, (void*)(&comando->argumento), 0, comparar_elementos, destruir_elemento);
+				borrar_elemento_pool (&lista, (void*)(&comando.argumento), 0, comparar_elementos, destruir_elemento, pool);
 				mostrar_lista(lista);
 				break;
 			case BORRARTODOS:
-				borrar_elemento (&lista, (void*)(&comando->argumento), 1, comparar_elementos, destruir_elemento);
+				borrar_elemento_pool (&lista, (void*)(&comando.argumento), 1, comparar_elementos, destruir_elemento, pool);
 				mostrar_lista(lista);
 				break;
 			case BUSCAR:
-				num = buscar_elemento (lista, (void*)(&comando->argumento), comparar_elementos);
+				num = buscar_elemento (lista, (void*)(&comando.argumento), comparar_elementos);
 				printf("%d ocurrencias", num);
 				break;
 			case AYUDA:
 				mostrar_ayuda ();
 				break;				
+			default:
+				break;
 		}
 		
 		// esto abajo del todo
-		free(comando);
-		comando = pedir_comando();
+		vaciar_salida();
+		pedir_comando(&comando);
 	}
-	free(comando);
 	
-	destruir_lista (&lista, destruir_elemento);
+	destruir_lista_pool (&lista, destruir_elemento, pool);
+	destruir_pool_nodos (pool);
 		
 	return 0;
 }